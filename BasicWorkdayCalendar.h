@@ -0,0 +1,1817 @@
+/**
+ * @file BasicWorkdayCalendar.h
+ * @brief Header file for the BasicWorkdayCalendar class template which manages workday calculations
+ * considering holidays and work hours on top of a statically known calendar type.
+ *
+ * The calendar type is a template parameter, so the calendar calls made while incrementing
+ * (isHoliday, nextWorkday, advanceWorkdays) are bound at compile time and can be inlined into
+ * the increment path. Instantiating the template with the abstract Calendar interface keeps the
+ * calendar behind a std::unique_ptr and dispatches virtually, which is what WorkdayCalendar uses.
+ * The work hours are a second template parameter: RuntimeWorkHours (set through
+ * setWorkdayStartAndStop) or FixedWorkHours, whose start, stop and duration are constants.
+ * Work hours whose stop lies before their start are overnight shifts, anchored to the day they start on;
+ * they ignore the per-date working windows, a date with its own window works the whole shift.
+ * Queries can also take a WorkHours value instead, so teams with different shifts can share
+ * one calendar and its holidays, or a WeeklySchedule with per-weekday intervals and breaks.
+ * Calendars with minute masks (MinuteMaskCalendar) carry their own working minutes and take over
+ * the working minute queries without any work hours.
+ * With a TimeZone the calendar's hours and holidays are read as local time of that zone while the
+ * queries take and return UTC; working windows follow the zone's daylight saving changes.
+ * Dates are rolled to workdays under a RollConvention with the calendar's next/previous workday
+ * lookups, one lookup (two for a modified convention leaving the month) per date.
+ * Bus/252 year fractions count the workdays between two days with the calendar's countWorkdaysDay,
+ * a prefix count subtraction on the indexed calendars.
+ * Period queries (the nth or last workday of a month, quarter or year, the workdays left in it)
+ * work from the bounds of the period without stepping through it: the count is a prefix count
+ * subtraction, the nth workday a select, a binary search over the prefix counts (O(log n) in the
+ * indexed words) and a scan of one word.
+ * workdays(from, to) returns the workdays of a window as a lazy bidirectional view (WorkdayRange.h).
+ * getWorkingMinutesBetween measures the working minutes between two times from the two partial days
+ * and one working minute count over the whole days between them (see SlaTimer).
+ * Coroutine generators stream working minute slots and working intervals from a start point; the
+ * start is validated once and each value resumes the walk where the previous one stopped.
+ * Internally the increment works on a day serial and the minutes of that day; the Date and
+ * epoch minute entry points only convert at the edges.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef BASIC_WORKDAY_CALENDAR_H
+#define BASIC_WORKDAY_CALENDAR_H
+
+#include "Calendar.h"
+#include "CalendarPeriod.h"
+#include "Date.h"
+#include "Generator.h"
+#include "RollConvention.h"
+#include "TimeUtils.h"
+#include "TimeZone.h"
+#include "ValidDate.h"
+#include "WeeklySchedule.h"
+#include "WorkdayRange.h"
+#include "WorkHours.h"
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+namespace Workday {
+
+    const int WORKWEEK_DURATION = 5;
+    const int BUS_252_DAYS_PER_YEAR = 252; ///< Business days per year of the Bus/252 day count
+
+    /**
+     * @struct WorkingInterval
+     * @brief A stretch of working time, [start, stop) in minutes since the epoch.
+     */
+    struct WorkingInterval {
+        std::int64_t start; ///< First working minute
+        std::int64_t stop;  ///< Minute after the last working minute
+    };
+
+    /**
+     * @class BasicWorkdayCalendar
+     * @brief Manages workday calculations considering holidays and work hours.
+     *
+     * @tparam CalendarT The calendar used for holiday and day arithmetic. A concrete calendar is
+     * stored by value and called directly; an abstract calendar is stored in a std::unique_ptr.
+     * @tparam WorkHoursT The work hour policy, RuntimeWorkHours or a FixedWorkHours.
+     */
+    template <typename CalendarT, typename WorkHoursT = RuntimeWorkHours>
+    class BasicWorkdayCalendar {
+    public:
+        /**
+         * @brief Storage used for the calendar: by value for concrete types, owning pointer otherwise.
+         */
+        using CalendarStorage = std::conditional_t<std::is_abstract_v<CalendarT>,
+            std::unique_ptr<CalendarT>, CalendarT>;
+
+        /**
+         * @brief Constructor for a default constructed concrete calendar.
+         */
+        BasicWorkdayCalendar() requires (!std::is_abstract_v<CalendarT>)
+            : work_hours_(), calendar_() {}
+
+        /**
+         * @brief Constructor taking ownership of the given calendar.
+         * @param calendar The calendar used for holiday and day arithmetic.
+         */
+        explicit BasicWorkdayCalendar(CalendarStorage calendar)
+            : work_hours_(), calendar_(std::move(calendar)) {}
+
+        /**
+         * @brief Sets the start and stop times for the working day. A stop before the start makes an
+         * overnight shift, which ignores the per-date working windows.
+         * @param start The start time of the working day.
+         * @param stop The stop time of the working day.
+         */
+        void setWorkdayStartAndStop(const Date& start, const Date& stop);
+
+        /**
+         * @brief Sets a specific date as a holiday.
+         * @param date The date to be set as a holiday.
+         */
+        void setHoliday(const Date& date);
+
+        /**
+         * @brief Sets a recurring holiday on the same date every year.
+         * @param date The date to be set as a recurring holiday.
+         */
+        void setRecurringHoliday(const Date& date);
+
+        /**
+         * @brief Gives a date its own working window (early close, working Saturday), if the calendar
+         * supports it. The window replaces the work hours on that date. Overnight work hours ignore
+         * the windows: the date is worked, with the whole shift, in increments and working minute counts.
+         * @param date The date, its time is ignored.
+         * @param start The start time of the window.
+         * @param stop The stop time of the window.
+         */
+        void setWorkingWindow(const Date& date, const Date& start, const Date& stop);
+
+        /**
+         * @brief Calculates the date after incrementing the specified number of workdays.
+         * Calendars with minute masks have no workday length and reject workday increments; use
+         * getWorkingMinutesIncrement on them.
+         * @param startDate The start date from which to calculate.
+         * @param incrementInWorkdays The number of workdays to increment (can be negative for decrement).
+         * @return The calculated date after the increment or invalid date if anything goes wrong.
+         */
+        Date getWorkdayIncrement(const Date& startDate, float incrementInWorkdays);
+
+        /**
+         * @brief Calculates the date after incrementing the specified number of workdays from an
+         * already validated start date, skipping the isValidDate check.
+         * @param startDate The validated start date from which to calculate.
+         * @param incrementInWorkdays The number of workdays to increment (can be negative for decrement).
+         * @return The calculated date after the increment or invalid date if anything goes wrong.
+         */
+        Date getWorkdayIncrement(const ValidDate& startDate, float incrementInWorkdays);
+
+        /**
+         * @brief Applies the same workday increment to a column of validated start dates.
+         * @param startDates The validated start dates.
+         * @param incrementInWorkdays The number of workdays to increment (can be negative for decrement).
+         * @param results Output, must hold startDates.size() entries; receives the calculated dates.
+         */
+        void getWorkdayIncrements(std::span<const ValidDate> startDates, float incrementInWorkdays,
+            std::span<Date> results);
+
+        /**
+         * @brief Calculates the date after incrementing an exact number of working minutes.
+         * Unlike getWorkdayIncrement no float arithmetic is involved, so long increments keep every minute.
+         * @param startDate The start date from which to calculate.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @return The calculated date after the increment or invalid date if anything goes wrong.
+         */
+        Date getWorkingMinutesIncrement(const Date& startDate, long long workingMinutes);
+
+        /**
+         * @brief Calculates the date after incrementing an exact number of working minutes from an
+         * already validated start date, skipping the isValidDate check.
+         * @param startDate The validated start date from which to calculate.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @return The calculated date after the increment or invalid date if anything goes wrong.
+         */
+        Date getWorkingMinutesIncrement(const ValidDate& startDate, long long workingMinutes);
+
+        /**
+         * @brief Calculates the time after incrementing an exact number of working minutes, with both
+         * ends given as minutes since 1970-01-01 00:00, without going through Date.
+         * @param epochMinutes The start time in minutes since the epoch.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @return The calculated time in minutes since the epoch, or INVALID_EPOCH_MINUTES if anything goes wrong.
+         */
+        std::int64_t getEpochMinutesIncrement(std::int64_t epochMinutes, long long workingMinutes);
+
+        /**
+         * @brief Applies the same working minute increment to a column of epoch minute timestamps.
+         * @param epochMinutes The start times in minutes since the epoch.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @param results Output, must hold epochMinutes.size() entries; receives the calculated times or
+         * INVALID_EPOCH_MINUTES.
+         */
+        void getEpochMinutesIncrements(std::span<const std::int64_t> epochMinutes, long long workingMinutes,
+            std::span<std::int64_t> results);
+
+        /**
+         * @brief Calculates the date after incrementing the specified number of workdays with the given
+         * work hours instead of the calendar's own, sharing the calendar's holidays.
+         * @param startDate The start date from which to calculate.
+         * @param incrementInWorkdays The number of workdays to increment (can be negative for decrement).
+         * @param hours The work hours used for this query.
+         * @return The calculated date after the increment or invalid date if anything goes wrong.
+         */
+        Date getWorkdayIncrement(const Date& startDate, float incrementInWorkdays, const WorkHours& hours);
+
+        /**
+         * @brief Calculates the date after incrementing an exact number of working minutes with the given
+         * work hours instead of the calendar's own, sharing the calendar's holidays.
+         * @param startDate The start date from which to calculate.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @param hours The work hours used for this query.
+         * @return The calculated date after the increment or invalid date if anything goes wrong.
+         */
+        Date getWorkingMinutesIncrement(const Date& startDate, long long workingMinutes, const WorkHours& hours);
+
+        /**
+         * @brief Applies the same working minute increment to a column of epoch minute timestamps with the
+         * given work hours instead of the calendar's own.
+         * @param epochMinutes The start times in minutes since the epoch.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @param hours The work hours used for this batch.
+         * @param results Output, must hold epochMinutes.size() entries; receives the calculated times or
+         * INVALID_EPOCH_MINUTES.
+         */
+        void getEpochMinutesIncrements(std::span<const std::int64_t> epochMinutes, long long workingMinutes,
+            const WorkHours& hours, std::span<std::int64_t> results);
+
+        /**
+         * @brief Calculates the date after incrementing an exact number of working minutes on a weekly
+         * schedule. A day is worked if the calendar has it as a workday and the schedule has intervals
+         * on its weekday. Moving forward ends at the end of the last minute worked, moving backward at
+         * the start of the last minute removed. Per-date working windows are not applied: a date with its
+         * own window is worked with the schedule of its weekday.
+         * @param startDate The start date from which to calculate.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @param schedule The working intervals of each weekday.
+         * @return The calculated date after the increment or invalid date if anything goes wrong.
+         */
+        Date getWorkingMinutesIncrement(const Date& startDate, long long workingMinutes, const WeeklySchedule& schedule);
+
+        /**
+         * @brief Applies the same working minute increment on a weekly schedule to a column of epoch minute
+         * timestamps.
+         * @param epochMinutes The start times in minutes since the epoch.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @param schedule The working intervals of each weekday.
+         * @param results Output, must hold epochMinutes.size() entries; receives the calculated times or
+         * INVALID_EPOCH_MINUTES.
+         */
+        void getEpochMinutesIncrements(std::span<const std::int64_t> epochMinutes, long long workingMinutes,
+            const WeeklySchedule& schedule, std::span<std::int64_t> results);
+
+        /**
+         * @brief Calculates the time after incrementing the specified number of workdays, on chrono time points.
+         * @param start The start time.
+         * @param incrementInWorkdays The number of workdays to increment (can be negative for decrement).
+         * @return The calculated time, or a time point counting INVALID_EPOCH_MINUTES if anything goes wrong.
+         */
+        SysMinutes getWorkdayIncrement(SysMinutes start, float incrementInWorkdays) {
+            if (!checkWorkdayLength()) {
+                return SysMinutes(std::chrono::minutes(INVALID_EPOCH_MINUTES));
+            }
+            return SysMinutes(std::chrono::minutes(getEpochMinutesIncrement(start.time_since_epoch().count(),
+                toWorkingMinutes(incrementInWorkdays, work_hours_.getDurationMinutes()))));
+        }
+
+        /**
+         * @brief Calculates the time after incrementing an exact working duration, on chrono time points.
+         * @param start The start time.
+         * @param workingTime The working time to increment (can be negative for decrement).
+         * @return The calculated time, or a time point counting INVALID_EPOCH_MINUTES if anything goes wrong.
+         */
+        SysMinutes getWorkingMinutesIncrement(SysMinutes start, std::chrono::minutes workingTime) {
+            return SysMinutes(std::chrono::minutes(
+                getEpochMinutesIncrement(start.time_since_epoch().count(), workingTime.count())));
+        }
+
+        /**
+         * @brief Calculates the UTC time after incrementing an exact number of working minutes, with the work
+         * hours and holidays taken as local time of the given zone. A daylight saving change inside a working
+         * window counts the minutes that actually elapse: a shift across the spring change works an hour less,
+         * across the autumn change an hour more. Calendars with minute masks count wall clock minutes.
+         * @param utcMinutes The start time in minutes since 1970-01-01 00:00 UTC.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @param zone The time zone the calendar's local time belongs to.
+         * @return The calculated time in minutes since 1970-01-01 00:00 UTC, or INVALID_EPOCH_MINUTES if
+         * anything goes wrong.
+         */
+        std::int64_t getUtcMinutesIncrement(std::int64_t utcMinutes, long long workingMinutes, const TimeZone& zone) {
+            return incrementUtcMinutes(work_hours_, utcMinutes, workingMinutes, zone);
+        }
+
+        /**
+         * @brief Applies the same working minute increment to a column of UTC epoch minute timestamps, with the
+         * work hours and holidays taken as local time of the given zone.
+         * @param utcMinutes The start times in minutes since 1970-01-01 00:00 UTC.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @param zone The time zone the calendar's local time belongs to.
+         * @param results Output, must hold utcMinutes.size() entries; receives the calculated UTC times or
+         * INVALID_EPOCH_MINUTES.
+         */
+        void getUtcMinutesIncrements(std::span<const std::int64_t> utcMinutes, long long workingMinutes,
+            const TimeZone& zone, std::span<std::int64_t> results) {
+            for (std::size_t i = 0; i < utcMinutes.size() && i < results.size(); ++i) {
+                results[i] = incrementUtcMinutes(work_hours_, utcMinutes[i], workingMinutes, zone);
+            }
+        }
+
+        /**
+         * @brief Calculates the UTC time after incrementing an exact working duration, on chrono time points,
+         * with the work hours and holidays taken as local time of the given zone.
+         * @param start The start time in UTC.
+         * @param workingTime The working time to increment (can be negative for decrement).
+         * @param zone The time zone the calendar's local time belongs to.
+         * @return The calculated UTC time, or a time point counting INVALID_EPOCH_MINUTES if anything goes wrong.
+         */
+        SysMinutes getWorkingMinutesIncrement(SysMinutes start, std::chrono::minutes workingTime, const TimeZone& zone) {
+            return SysMinutes(std::chrono::minutes(
+                incrementUtcMinutes(work_hours_, start.time_since_epoch().count(), workingTime.count(), zone)));
+        }
+
+        /**
+         * @brief Moves a time given as a day serial and the minutes of that day by an exact number of working
+         * minutes with the calendar's own work hours. The time is not validated, so callers chaining several
+         * calendars (see FollowTheSun) carry the same two integers from one calendar to the next.
+         * @param day The day serial, updated to the resulting day.
+         * @param minuteOfDay The time in minutes since midnight, updated to the resulting time.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @return True on success, false if the calendar or the work hours are not usable.
+         */
+        bool advanceWorkingMinutes(int& day, int& minuteOfDay, long long workingMinutes) {
+            return incrementDayAndMinutes(work_hours_, day, minuteOfDay, workingMinutes);
+        }
+
+        /**
+         * @brief Rolls a date that is not a workday to a workday; workdays are returned unchanged.
+         * @param date The date to roll, its time is kept.
+         * @param convention The roll convention.
+         * @return The rolled date or invalid date if anything goes wrong.
+         */
+        Date getRolledDate(const Date& date, RollConvention convention);
+
+        /**
+         * @brief Rolls a column of days to workdays under one convention.
+         * @param days The days to roll.
+         * @param convention The roll convention.
+         * @param results Output, must hold days.size() entries; receives the rolled days.
+         * @return False if the calendar is not usable, the results are then left untouched.
+         */
+        bool getRolledDays(std::span<const std::chrono::sys_days> days, RollConvention convention,
+            std::span<std::chrono::sys_days> results);
+
+        /**
+         * @brief Rolls a day serial to a workday.
+         * @param day The day serial, updated to the rolled day.
+         * @param convention The roll convention.
+         * @return True on success, false if the calendar is not usable.
+         */
+        bool rollDay(int& day, RollConvention convention) {
+            if (!hasCalendar()) {
+                Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+                return false;
+            }
+            day = rollValidDay(day, convention);
+            return true;
+        }
+
+        /**
+         * @brief Calculates the Bus/252 year fraction: the workdays in [from, to) divided by 252.
+         * @param from The first date, its time is ignored.
+         * @param to The date after the last one counted, its time is ignored.
+         * @return The year fraction, negative if to is before from, NaN if anything goes wrong.
+         */
+        double yearFractionBus252(const Date& from, const Date& to);
+
+        /**
+         * @brief Calculates the Bus/252 year fraction: the workdays in [from, to) divided by 252.
+         * @param from The first day.
+         * @param to The day after the last one counted.
+         * @return The year fraction, negative if to is before from, NaN if the calendar is not usable.
+         */
+        double yearFractionBus252(std::chrono::sys_days from, std::chrono::sys_days to);
+
+        /**
+         * @brief Calculates the Bus/252 year fractions of a column of day pairs.
+         * @param from The first days.
+         * @param to The days after the last ones counted, paired with from by position.
+         * @param results Output, must hold from.size() entries; receives the year fractions.
+         * @return False if the calendar is not usable, the results are then left untouched.
+         */
+        bool yearFractionsBus252(std::span<const std::chrono::sys_days> from, std::span<const std::chrono::sys_days> to,
+            std::span<double> results);
+
+        /**
+         * @brief Finds the nth workday of the period containing a date.
+         * @param date The date, its time is kept.
+         * @param period The period.
+         * @param nth 1 for the first workday, 2 for the second...; -1 for the last, -2 for the one before...
+         * @return The workday or invalid date if the period has fewer workdays or anything goes wrong.
+         */
+        Date getNthWorkdayOfPeriod(const Date& date, CalendarPeriod period, int nth);
+
+        /**
+         * @brief Finds the last workday of the period containing a date.
+         * @param date The date, its time is kept.
+         * @param period The period.
+         * @return The workday or invalid date if the period has none or anything goes wrong.
+         */
+        Date getLastWorkdayOfPeriod(const Date& date, CalendarPeriod period) {
+            return getNthWorkdayOfPeriod(date, period, -1);
+        }
+
+        /**
+         * @brief Counts the workdays from a date, included, to the end of its period.
+         * @param date The date.
+         * @param period The period.
+         * @return The number of workdays, or -1 if anything goes wrong.
+         */
+        int getWorkdaysRemaining(const Date& date, CalendarPeriod period);
+
+        /**
+         * @brief Finds the nth workday of the period of each day in a column.
+         * @param days The days, one per period asked for.
+         * @param period The period.
+         * @param nth 1 for the first workday, 2 for the second...; -1 for the last, -2 for the one before...
+         * @param results Output, must hold days.size() entries; receives the workdays, or
+         * std::chrono::sys_days::min() where the period has fewer workdays.
+         * @return False if the calendar is not usable or nth is 0, the results are then left untouched.
+         */
+        bool getNthWorkdaysOfPeriod(std::span<const std::chrono::sys_days> days, CalendarPeriod period, int nth,
+            std::span<std::chrono::sys_days> results);
+
+        /**
+         * @brief Returns the workdays of [from, to) as a lazy view. The view refers to the calendar,
+         * which must outlive it.
+         * @param from The first day of the window.
+         * @param to The day after the last day of the window.
+         * @return The view, empty if the calendar is not usable or to is not after from.
+         */
+        BasicWorkdayRange<CalendarT> workdays(std::chrono::sys_days from, std::chrono::sys_days to) {
+            //check calendar valid
+            if (!hasCalendar()) {
+                Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+                return BasicWorkdayRange<CalendarT>();
+            }
+            return BasicWorkdayRange<CalendarT>(&calendar(), static_cast<int>(from.time_since_epoch().count()),
+                static_cast<int>(to.time_since_epoch().count()));
+        }
+
+        /**
+         * @brief Returns the workdays of [from, to) as a lazy view, ignoring the time of the dates.
+         * @param from The first day of the window.
+         * @param to The day after the last day of the window.
+         * @return The view, empty if the calendar is not usable, a date is invalid or to is not after from.
+         */
+        BasicWorkdayRange<CalendarT> workdays(const Date& from, const Date& to) {
+            if (!checkStartDate(from) || !checkStartDate(to)) {
+                return BasicWorkdayRange<CalendarT>();
+            }
+            return BasicWorkdayRange<CalendarT>(&calendar(), TimeUtils::toDaySerial(from), TimeUtils::toDaySerial(to));
+        }
+
+        /**
+         * @brief Streams the times reached by repeatedly incrementing a number of working minutes: the
+         * first value is the start plus slotMinutes, each next one slotMinutes further. The sequence
+         * ends only if an increment fails. The calendar must outlive the generator.
+         * @param epochMinutes The start time in minutes since the epoch.
+         * @param slotMinutes The working minutes between two values, negative to go backwards, not 0.
+         * @return The generator, empty if the start or the slot is invalid.
+         */
+        Generator<std::int64_t> generateWorkingSlots(std::int64_t epochMinutes, long long slotMinutes);
+
+        /**
+         * @brief Streams the working intervals of the calendar's work hours from a start time on, the
+         * first one cut at the start. Days with their own working window use that window. The sequence
+         * is unbounded; calendars with minute masks yield nothing. The calendar must outlive the generator.
+         * @param epochMinutes The start time in minutes since the epoch.
+         * @return The generator, empty if the start, the calendar or the work hours are not usable.
+         */
+        Generator<WorkingInterval> generateWorkingIntervals(std::int64_t epochMinutes);
+
+        /**
+         * @brief Counts the working minutes of the calendar's work hours in [from, to).
+         * @param from The first minute, in minutes since the epoch.
+         * @param to The minute after the last one, in minutes since the epoch.
+         * @return The working minutes, 0 if to is not after from, -1 if anything goes wrong.
+         */
+        long long getWorkingMinutesBetween(std::int64_t from, std::int64_t to);
+
+        /**
+         * @brief Returns the workday start
+         */
+        Date* getWorkdayStart() {
+            return work_hours_.getStart();
+        }
+
+        /**
+         * @brief Returns the workday end
+         */
+        Date* getWorkdayStop() {
+            return work_hours_.getStop();
+        }
+
+        /**
+         * @brief Returns true if it is a holiday
+         */
+        bool isHoliday(Date date_i) {
+            return calendar().isHoliday(date_i);
+        }
+
+        /**
+         * @brief Returns true if the chrono day is a holiday
+         */
+        bool isHoliday(std::chrono::sys_days day) {
+            return calendar().isHolidayDay(static_cast<int>(day.time_since_epoch().count()));
+        }
+
+    protected:
+        /**
+         * @brief Returns the calendar regardless of how it is stored.
+         */
+        CalendarT& calendar() {
+            if constexpr (std::is_abstract_v<CalendarT>) {
+                return *calendar_;
+            }
+            else {
+                return calendar_;
+            }
+        }
+
+        /**
+         * @brief Returns true if a calendar is available.
+         */
+        bool hasCalendar() const {
+            if constexpr (std::is_abstract_v<CalendarT>) {
+                return calendar_ != nullptr;
+            }
+            else {
+                return true;
+            }
+        }
+
+    private:
+        /**
+         * @brief Checks the calendar and the start date before an increment.
+         * @param startDate The start date to check.
+         * @return True if the increment can be calculated.
+         */
+        bool checkStartDate(const Date& startDate);
+
+        /**
+         * @brief Checks that workday increments can be turned into working minutes: calendars with minute
+         * masks replace the work hours and have no workday length.
+         * @return True if the work hours give the workday length.
+         */
+        bool checkWorkdayLength();
+
+        /**
+         * @brief Rolls a day serial to a workday on a calendar known to be set.
+         * @param day The day serial.
+         * @param convention The roll convention.
+         * @return The day serial of the rolled day.
+         */
+        int rollValidDay(int day, RollConvention convention);
+
+        /**
+         * @brief Returns the bounds of the period containing a day.
+         * @param day The day serial.
+         * @param period The period.
+         * @param first Receives the day serial of the first day of the period.
+         * @param end Receives the day serial one past the last day of the period.
+         */
+        static void periodBounds(int day, CalendarPeriod period, int& first, int& end) {
+            const auto [year, month, unused_day] = TimeUtils::civilFromDays(day);
+            const int first_month = period == CalendarPeriod::Month ? month
+                : period == CalendarPeriod::Quarter ? month - (month - 1) % 3 : 1;
+            const int months = period == CalendarPeriod::Month ? 1 : period == CalendarPeriod::Quarter ? 3 : 12;
+            first = TimeUtils::daysFromCivil(year, first_month, 1);
+            const int end_month = first_month + months;
+            end = end_month > 12 ? TimeUtils::daysFromCivil(year + 1, end_month - 12, 1)
+                : TimeUtils::daysFromCivil(year, end_month, 1);
+        }
+
+        /**
+         * @brief Selects the nth workday of a period on a calendar known to be set. One advanceWorkdaysDay
+         * call, a logarithmic select on the indexed calendars.
+         * @param day A day serial in the period.
+         * @param period The period.
+         * @param nth The workday rank, negative to count from the end, not 0.
+         * @return The day serial of the workday, or nothing if the period has fewer workdays.
+         */
+        std::optional<int> nthWorkdayOfValidPeriod(int day, CalendarPeriod period, int nth) {
+            int first = 0;
+            int end = 0;
+            periodBounds(day, period, first, end);
+            // Advancing from the day before the period (or the day after it) lands on the nth workday
+            const int workday = nth > 0 ? calendar().advanceWorkdaysDay(first - 1, nth)
+                : calendar().advanceWorkdaysDay(end, nth);
+            if (workday < first || workday >= end) {
+                return std::nullopt;
+            }
+            return workday;
+        }
+
+        /**
+         * @brief Counts the working minutes in [from, to) on a calendar and work hours known to be set.
+         * @param hours The work hours.
+         * @param from The first minute, in minutes since the epoch.
+         * @param to The minute after the last one, after from.
+         * @return The working minutes.
+         */
+        template <typename HoursT>
+        long long countWorkedMinutes(const HoursT& hours, std::int64_t from, std::int64_t to);
+
+        /**
+         * @brief Calculates a Bus/252 year fraction on a calendar known to be set.
+         * @param from The first day serial.
+         * @param to The day serial after the last one counted.
+         * @return The year fraction, negative if to is before from.
+         */
+        double bus252ValidDays(int from, int to) {
+            if (to < from) {
+                return -bus252ValidDays(to, from);
+            }
+            return static_cast<double>(calendar().countWorkdaysDay(from, to)) / BUS_252_DAYS_PER_YEAR;
+        }
+
+        /**
+         * @brief Converts a fractional workday increment to working minutes, truncating toward zero.
+         * @param incrementInWorkdays The number of workdays.
+         * @param workdayInMinutes The length of the working day in minutes.
+         * @return The number of working minutes.
+         */
+        static long long toWorkingMinutes(float incrementInWorkdays, int workdayInMinutes) {
+            return static_cast<long long>(incrementInWorkdays * workdayInMinutes);
+        }
+
+        /**
+         * @brief Calculates the working minute increment from a start date that is known to be valid.
+         * @param hours The work hours, the calendar's own or a per query WorkHours.
+         * @param startDate The start date from which to calculate.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @return The calculated date after the increment or invalid date if anything goes wrong.
+         */
+        template <typename HoursT>
+        Date incrementValidDate(const HoursT& hours, const Date& startDate, long long workingMinutes);
+
+        /**
+         * @brief Calculates the working minute increment from an epoch minute time.
+         * @param hours The work hours, the calendar's own or a per query WorkHours.
+         * @param epochMinutes The start time in minutes since the epoch.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @return The calculated time in minutes since the epoch, or INVALID_EPOCH_MINUTES if anything goes wrong.
+         */
+        template <typename HoursT>
+        std::int64_t incrementEpochMinutes(const HoursT& hours, std::int64_t epochMinutes, long long workingMinutes);
+
+        /**
+         * @brief Runs the increment on local time of a zone, rerun with the wall clock minutes corrected for
+         * the daylight saving changes crossed inside working windows until the changes crossed settle.
+         * @param hours The work hours, the calendar's own or a per query WorkHours.
+         * @param utcMinutes The start time in minutes since the epoch, UTC.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @param zone The time zone of the calendar's local time.
+         * @return The calculated UTC time in minutes since the epoch, or INVALID_EPOCH_MINUTES if anything goes wrong
+         * or the correction does not settle within a few rounds.
+         */
+        template <typename HoursT>
+        std::int64_t incrementUtcMinutes(const HoursT& hours, std::int64_t utcMinutes, long long workingMinutes,
+            const TimeZone& zone);
+
+        /**
+         * @brief Counts the working minutes among the local wall clock minutes [localFrom, localTo).
+         * @param hours The work hours.
+         * @param localFrom The first local minute, in minutes since the epoch.
+         * @param localTo The local minute one past the last, in minutes since the epoch.
+         * @return The working minutes; zero for calendars with minute masks.
+         */
+        template <typename HoursT>
+        long long workedWallMinutes(const HoursT& hours, std::int64_t localFrom, std::int64_t localTo);
+
+        /**
+         * @brief Core of the increment on a day serial and the minutes of that day.
+         * @param hours The work hours, the calendar's own or a per query WorkHours.
+         * @param day The start day serial, updated to the resulting day.
+         * @param minuteOfDay The start time in minutes since midnight, updated to the resulting time.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @return True on success, false if the calendar or the work hours are not usable.
+         */
+        template <typename HoursT>
+        bool incrementDayAndMinutes(const HoursT& hours, int& day, int& minuteOfDay, long long workingMinutes);
+
+        /**
+         * @brief Core of the increment for work hours with the same window on every workday, within one day.
+         * @param hours The work hours, start before stop.
+         * @param day The start day serial, updated to the resulting day.
+         * @param minuteOfDay The start time in minutes since midnight, updated to the resulting time.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         */
+        template <typename HoursT>
+        void incrementUniform(const HoursT& hours, int& day, int& minuteOfDay, long long workingMinutes);
+
+        /**
+         * @brief Core of the increment for overnight shifts. The shift of day d covers the absolute minutes
+         * [d * MINUTES_IN_DAY + start, d * MINUTES_IN_DAY + start + duration), so measured from the shift
+         * start every shift lies within one day and the same-day core applies to the shifted time. Per-date
+         * working windows are not applied, their dates count as ordinary workdays.
+         * @param hours The work hours, stop before start.
+         * @param day The start day serial, updated to the resulting day.
+         * @param minuteOfDay The start time in minutes since midnight, updated to the resulting time.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         */
+        template <typename HoursT>
+        void incrementOvernight(const HoursT& hours, int& day, int& minuteOfDay, long long workingMinutes);
+
+        /**
+         * @brief Core of the increment for calendars with per-date working windows. Walks the days with
+         * their own window one by one and jumps over the ordinary workdays between them. Times outside a window
+         * and increments ending on a window edge follow addRemainingMinutes and removeRemainingMinutes, so
+         * away from the days with their own window the results match incrementUniform.
+         * @param hours The work hours of the ordinary workdays.
+         * @param day The start day serial, updated to the resulting day.
+         * @param minuteOfDay The start time in minutes since midnight, updated to the resulting time.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         */
+        template <typename HoursT>
+        void incrementWithWindows(const HoursT& hours, int& day, int& minuteOfDay, long long workingMinutes);
+
+        /**
+         * @brief Core of the increment on a weekly schedule, on a day serial and the minutes of that day.
+         * Walks the partial days and skips the whole weeks between them with one calendar count. Days with
+         * their own working window count as ordinary workdays of their weekday.
+         * @param schedule The working intervals of each weekday.
+         * @param day The start day serial, updated to the resulting day.
+         * @param minuteOfDay The start time in minutes since midnight, updated to the resulting time.
+         * @param workingMinutes The number of working minutes to increment (can be negative for decrement).
+         * @return True on success, false if the calendar or the schedule are not usable.
+         */
+        bool incrementOnSchedule(const WeeklySchedule& schedule, int& day, int& minuteOfDay, long long workingMinutes);
+
+        /**
+         * @brief Increments or decrements the given day by a workday.
+         * @param day The day serial to be incremented or decremented.
+         * @param decrement Indicates if the day should be decremented.
+         */
+        void incrementWorkDay(int& day, bool decrement = false);
+
+        /**
+         * @brief Adds the remaining minutes to the given day and time.
+         * @param hours The work hours.
+         * @param minutes The number of minutes to add.
+         * @param day The current day serial.
+         * @param currentMinutes The current time in minutes since midnight.
+         */
+        template <typename HoursT>
+        void addRemainingMinutes(const HoursT& hours, int minutes, int& day, int& currentMinutes);
+
+        /**
+         * @brief Removes the remaining minutes from the given day and time.
+         * @param hours The work hours.
+         * @param minutes The number of minutes to remove.
+         * @param day The current day serial.
+         * @param currentMinutes The current time in minutes since midnight.
+         */
+        template <typename HoursT>
+        void removeRemainingMinutes(const HoursT& hours, int minutes, int& day, int& currentMinutes);
+
+    private:
+        WorkHoursT work_hours_; ///< Workday start, stop & duration
+        CalendarStorage calendar_;
+        std::mutex mtx_;  ///< Mutex for thread safety
+    };
+
+    // **Sets workday start and stop times**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::setWorkdayStartAndStop(const Date& start, const Date& stop) {
+
+        try {
+            std::lock_guard<std::mutex> lock(mtx_);  // Acquires a lock on the mutex for thread safety
+
+            //check the incoming date is valid
+            if (!calendar().isValidDate(start)) {
+                // return invalid date
+                Logger::getInstance().logInfo("Invalid startdate", LOG_LOCATION);
+                work_hours_.reset();
+                return;
+            }
+
+            //check the incoming date is valid
+            if (!calendar().isValidDate(stop)) {
+                // return invalid date
+                Logger::getInstance().logInfo("Invalid stopdate", LOG_LOCATION);
+                work_hours_.reset();
+                return;
+            }
+
+            work_hours_.set(start, stop);  // Stores start, stop and the resulting workday duration
+        }
+        catch (std::exception e) {
+            Logger::getInstance().logError(e.what(), LOG_LOCATION);
+        }
+    }
+
+    // **Sets a per-date working window**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::setWorkingWindow(const Date& date, const Date& start, const Date& stop) {
+        try {
+            std::lock_guard<std::mutex> lock(mtx_);
+            calendar().setWorkingWindow(date, TimeUtils::convertToMinutes(start.getTime()),
+                TimeUtils::convertToMinutes(stop.getTime()));
+        }
+        catch (std::exception e) {
+            Logger::getInstance().logError(e.what(), LOG_LOCATION);
+        }
+    }
+
+    // **Sets a one-time holiday**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::setHoliday(const Date& date) {
+        try {
+            std::lock_guard<std::mutex> lock(mtx_);
+            calendar().setHoliday(date);
+        }
+        catch (std::exception e) {
+            Logger::getInstance().logError(e.what(), LOG_LOCATION);
+        }
+    }
+
+    // **Sets a recurring holiday**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::setRecurringHoliday(const Date& date) {
+        try {
+            std::lock_guard<std::mutex> lock(mtx_);
+            calendar().setRecurringHoliday(date);
+        }
+        catch (std::exception e) {
+            Logger::getInstance().logError(e.what(), LOG_LOCATION);
+        }
+    }
+
+    // **Increments or decrements a work day considering holidays**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementWorkDay(int& day, bool decrement) {
+        if (decrement) {
+            day = calendar().previousWorkdayDay(day);
+        }
+        else {
+            day = calendar().nextWorkdayDay(day);
+        }
+    }
+
+    // **Adds remaining minutes to a day and time within workday limits**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::addRemainingMinutes(const HoursT& hours, int minutes, int& day, int& currentMinutes) {
+        // Workday start and stop times in minutes for easier comparison
+        const int stop_minutes = hours.getStopMinutes();
+        const int start_minutes = hours.getStartMinutes();
+
+        // Check if current time is past workday stop time
+        // If so, reset to next workday start
+        if (currentMinutes >= stop_minutes) {
+            incrementWorkDay(day);
+            currentMinutes = start_minutes;
+        }
+        // Check if current time is before workday start time
+        // If so, reset to workday start
+        else if (currentMinutes < start_minutes) {
+            currentMinutes = start_minutes;
+        }
+
+        // If adding minutes keeps the time within workday limits, add them directly
+        if ((currentMinutes + minutes) <= stop_minutes) {
+            currentMinutes += minutes;
+        }
+        else {
+            // If adding minutes goes past workday stop, handle overflow
+            incrementWorkDay(day);
+            currentMinutes = start_minutes + (currentMinutes + minutes) - stop_minutes;
+        }
+    }
+
+    // **Function to remove remaining minutes within workday limits**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::removeRemainingMinutes(const HoursT& hours, int minutes, int& day, int& currentMinutes) {
+        // Workday start and stop times in minutes for easier comparison
+        const int stop_minutes = hours.getStopMinutes();
+        const int start_minutes = hours.getStartMinutes();
+
+        // Check if current time is past workday stop time
+        // If so, reset to workday stop
+        if (currentMinutes >= stop_minutes) {
+            currentMinutes = stop_minutes;
+        }
+        // Check if current time is before workday start time
+        // If so, decrement to previous workday stop
+        else if (currentMinutes < start_minutes) {
+            incrementWorkDay(day, true);
+            currentMinutes = stop_minutes;
+        }
+
+        // If subtracting minutes keeps the time within workday limits, subtract them directly
+        if ((currentMinutes - minutes) >= start_minutes) {
+            currentMinutes -= minutes;
+        }
+        else {
+            // If subtracting minutes goes before workday start, handle underflow
+            incrementWorkDay(day, true);
+            currentMinutes = stop_minutes - (start_minutes - (currentMinutes - minutes));
+        }
+    }
+
+    // **Minute masks replace the work hours, so there is no workday to scale the increment by**
+    template <typename CalendarT, typename WorkHoursT>
+    bool BasicWorkdayCalendar<CalendarT, WorkHoursT>::checkWorkdayLength() {
+        if (!hasCalendar()) {
+            return true; // left to the increment, which logs the missing calendar
+        }
+        CalendarT& cal = calendar();
+        if constexpr (requires { cal.hasMinuteMasks(); }) {
+            if (cal.hasMinuteMasks()) {
+                Logger::getInstance().logInfo("Workday increments need work hours, not minute masks", LOG_LOCATION);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // **Checks the calendar and the incoming date**
+    template <typename CalendarT, typename WorkHoursT>
+    bool BasicWorkdayCalendar<CalendarT, WorkHoursT>::checkStartDate(const Date& startDate) {
+        //check calendar valid
+        if (!hasCalendar()) {
+            Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+            return false;
+        }
+
+        //check the incoming date is valid
+        if (!calendar().isValidDate(startDate)) {
+            Logger::getInstance().logInfo("Invalid startdate", LOG_LOCATION);
+            return false;
+        }
+        return true;
+    }
+
+    // **Function to calculate a date after incrementing by workdays**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkdayIncrement(const Date& startDate, float incrementInWorkdays) {
+        if (!checkStartDate(startDate) || !checkWorkdayLength()) {
+            // return invalid date
+            return startDate.generateInvalidDate();
+        }
+        return incrementValidDate(work_hours_, startDate,
+            toWorkingMinutes(incrementInWorkdays, work_hours_.getDurationMinutes()));
+    }
+
+    // **Function to calculate a date after incrementing by workdays with per query work hours**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkdayIncrement(const Date& startDate, float incrementInWorkdays,
+        const WorkHours& hours) {
+        if (!checkStartDate(startDate) || !checkWorkdayLength()) {
+            // return invalid date
+            return startDate.generateInvalidDate();
+        }
+        return incrementValidDate(hours, startDate, toWorkingMinutes(incrementInWorkdays, hours.getDurationMinutes()));
+    }
+
+    // **Function to calculate a date after incrementing by workdays from a validated date**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkdayIncrement(const ValidDate& startDate, float incrementInWorkdays) {
+        if (!checkWorkdayLength()) {
+            // return invalid date
+            return startDate.getDate().generateInvalidDate();
+        }
+        return incrementValidDate(work_hours_, startDate.getDate(),
+            toWorkingMinutes(incrementInWorkdays, work_hours_.getDurationMinutes()));
+    }
+
+    // **Function to apply one workday increment to a column of validated dates**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkdayIncrements(std::span<const ValidDate> startDates,
+        float incrementInWorkdays, std::span<Date> results) {
+        if (!checkWorkdayLength()) {
+            for (std::size_t i = 0; i < startDates.size() && i < results.size(); ++i) {
+                results[i] = startDates[i].getDate().generateInvalidDate();
+            }
+            return;
+        }
+        const long long workingMinutes = toWorkingMinutes(incrementInWorkdays, work_hours_.getDurationMinutes());
+        for (std::size_t i = 0; i < startDates.size() && i < results.size(); ++i) {
+            results[i] = incrementValidDate(work_hours_, startDates[i].getDate(), workingMinutes);
+        }
+    }
+
+    // **Rolls the day of a date, keeping its time**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getRolledDate(const Date& date, RollConvention convention) {
+        if (!checkStartDate(date)) {
+            // return invalid date
+            return date.generateInvalidDate();
+        }
+        Date rolled = date;
+        TimeUtils::setDaySerial(rolled, rollValidDay(TimeUtils::toDaySerial(date), convention));
+        return rolled;
+    }
+
+    // **Function to roll a column of days under one convention**
+    template <typename CalendarT, typename WorkHoursT>
+    bool BasicWorkdayCalendar<CalendarT, WorkHoursT>::getRolledDays(std::span<const std::chrono::sys_days> days,
+        RollConvention convention, std::span<std::chrono::sys_days> results) {
+        //check calendar valid
+        if (!hasCalendar()) {
+            Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+            return false;
+        }
+        for (std::size_t i = 0; i < days.size() && i < results.size(); ++i) {
+            const int day = static_cast<int>(days[i].time_since_epoch().count());
+            results[i] = std::chrono::sys_days(std::chrono::days(rollValidDay(day, convention)));
+        }
+        return true;
+    }
+
+    // **One next/previous workday lookup, a second one in the other direction when a modified roll leaves the month**
+    template <typename CalendarT, typename WorkHoursT>
+    int BasicWorkdayCalendar<CalendarT, WorkHoursT>::rollValidDay(int day, RollConvention convention) {
+        CalendarT& cal = calendar();
+        if (!cal.isHolidayDay(day)) {
+            return day;
+        }
+        const bool forward = convention == RollConvention::Following || convention == RollConvention::ModifiedFollowing;
+        const int rolled = forward ? cal.nextWorkdayDay(day) : cal.previousWorkdayDay(day);
+        if (convention == RollConvention::Following || convention == RollConvention::Preceding) {
+            return rolled;
+        }
+        // Modified: stay within the month of the date
+        const auto [year, month, unused_day] = TimeUtils::civilFromDays(day);
+        const auto [rolled_year, rolled_month, rolled_day] = TimeUtils::civilFromDays(rolled);
+        if (rolled_year == year && rolled_month == month) {
+            return rolled;
+        }
+        return forward ? cal.previousWorkdayDay(day) : cal.nextWorkdayDay(day);
+    }
+
+    // **Counts the workdays between the day serials of the dates**
+    template <typename CalendarT, typename WorkHoursT>
+    double BasicWorkdayCalendar<CalendarT, WorkHoursT>::yearFractionBus252(const Date& from, const Date& to) {
+        if (!checkStartDate(from) || !checkStartDate(to)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        return bus252ValidDays(TimeUtils::toDaySerial(from), TimeUtils::toDaySerial(to));
+    }
+
+    // **Counts the workdays between the chrono days**
+    template <typename CalendarT, typename WorkHoursT>
+    double BasicWorkdayCalendar<CalendarT, WorkHoursT>::yearFractionBus252(std::chrono::sys_days from, std::chrono::sys_days to) {
+        //check calendar valid
+        if (!hasCalendar()) {
+            Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        return bus252ValidDays(static_cast<int>(from.time_since_epoch().count()),
+            static_cast<int>(to.time_since_epoch().count()));
+    }
+
+    // **Function to calculate the year fractions of a column of day pairs**
+    template <typename CalendarT, typename WorkHoursT>
+    bool BasicWorkdayCalendar<CalendarT, WorkHoursT>::yearFractionsBus252(std::span<const std::chrono::sys_days> from,
+        std::span<const std::chrono::sys_days> to, std::span<double> results) {
+        //check calendar valid
+        if (!hasCalendar()) {
+            Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+            return false;
+        }
+        for (std::size_t i = 0; i < from.size() && i < to.size() && i < results.size(); ++i) {
+            results[i] = bus252ValidDays(static_cast<int>(from[i].time_since_epoch().count()),
+                static_cast<int>(to[i].time_since_epoch().count()));
+        }
+        return true;
+    }
+
+    // **Selects the workday from the period bounds and keeps the time of the date**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getNthWorkdayOfPeriod(const Date& date, CalendarPeriod period, int nth) {
+        if (!checkStartDate(date)) {
+            // return invalid date
+            return date.generateInvalidDate();
+        }
+        std::optional<int> workday = nth == 0 ? std::nullopt
+            : nthWorkdayOfValidPeriod(TimeUtils::toDaySerial(date), period, nth);
+        if (!workday) {
+            Logger::getInstance().logInfo("No such workday in the period", LOG_LOCATION);
+            return date.generateInvalidDate();
+        }
+        Date result = date;
+        TimeUtils::setDaySerial(result, *workday);
+        return result;
+    }
+
+    // **Counts the workdays between the date and the end of the period**
+    template <typename CalendarT, typename WorkHoursT>
+    int BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkdaysRemaining(const Date& date, CalendarPeriod period) {
+        if (!checkStartDate(date)) {
+            return -1;
+        }
+        const int day = TimeUtils::toDaySerial(date);
+        int first = 0;
+        int end = 0;
+        periodBounds(day, period, first, end);
+        return calendar().countWorkdaysDay(day, end);
+    }
+
+    // **Function to find the nth workday of the period of each day in a column**
+    template <typename CalendarT, typename WorkHoursT>
+    bool BasicWorkdayCalendar<CalendarT, WorkHoursT>::getNthWorkdaysOfPeriod(std::span<const std::chrono::sys_days> days,
+        CalendarPeriod period, int nth, std::span<std::chrono::sys_days> results) {
+        //check calendar valid
+        if (!hasCalendar() || nth == 0) {
+            Logger::getInstance().logInfo("Invalid calendar or workday rank", LOG_LOCATION);
+            return false;
+        }
+        for (std::size_t i = 0; i < days.size() && i < results.size(); ++i) {
+            std::optional<int> workday = nthWorkdayOfValidPeriod(static_cast<int>(days[i].time_since_epoch().count()), period, nth);
+            results[i] = workday ? std::chrono::sys_days(std::chrono::days(*workday)) : std::chrono::sys_days::min();
+        }
+        return true;
+    }
+
+    // **Validates the start once, then carries day and minutes from one slot to the next**
+    template <typename CalendarT, typename WorkHoursT>
+    Generator<std::int64_t> BasicWorkdayCalendar<CalendarT, WorkHoursT>::generateWorkingSlots(std::int64_t epochMinutes,
+        long long slotMinutes) {
+        //check the incoming time and slot are valid
+        if (!TimeUtils::isValidEpochMinutes(epochMinutes) || slotMinutes == 0) {
+            Logger::getInstance().logInfo("Invalid start time or slot", LOG_LOCATION);
+            co_return;
+        }
+
+        int day = 0;
+        int minuteOfDay = 0;
+        TimeUtils::splitEpochMinutes(epochMinutes, day, minuteOfDay);
+        while (incrementDayAndMinutes(work_hours_, day, minuteOfDay, slotMinutes)) {
+            co_yield TimeUtils::joinEpochMinutes(day, minuteOfDay);
+        }
+    }
+
+    // **Yields the window of each workday, jumping between workdays with the calendar's lookups**
+    template <typename CalendarT, typename WorkHoursT>
+    Generator<WorkingInterval> BasicWorkdayCalendar<CalendarT, WorkHoursT>::generateWorkingIntervals(std::int64_t epochMinutes) {
+        //check the incoming time, calendar and work hours are valid
+        if (!TimeUtils::isValidEpochMinutes(epochMinutes) || !hasCalendar() || !work_hours_.isSet()) {
+            Logger::getInstance().logInfo("Invalid start time, calendar or work hours", LOG_LOCATION);
+            co_return;
+        }
+        CalendarT& cal = calendar();
+        if constexpr (requires { cal.hasMinuteMasks(); }) {
+            if (cal.hasMinuteMasks()) {
+                Logger::getInstance().logInfo("Working intervals not supported with minute masks", LOG_LOCATION);
+                co_return;
+            }
+        }
+
+        const bool overnight = work_hours_.isOvernight();
+        int day = 0;
+        int minuteOfDay = 0;
+        TimeUtils::splitEpochMinutes(epochMinutes, day, minuteOfDay);
+        // Last night's shift may still be running at the start
+        if (overnight) {
+            --day;
+        }
+        if (cal.isHolidayDay(day)) {
+            day = cal.nextWorkdayDay(day);
+        }
+        while (true) {
+            int start = work_hours_.getStartMinutes();
+            int stop = work_hours_.getStopMinutes();
+            if constexpr (requires { cal.hasWindowOverrides(); }) {
+                if (!overnight) {
+                    cal.getWindowOverride(day, start, stop);
+                }
+            }
+            if (overnight) {
+                stop += MINUTES_IN_DAY;
+            }
+            const std::int64_t interval_start = std::max(TimeUtils::joinEpochMinutes(day, start), epochMinutes);
+            const std::int64_t interval_stop = TimeUtils::joinEpochMinutes(day, stop);
+            if (interval_start < interval_stop) {
+                co_yield WorkingInterval{ interval_start, interval_stop };
+            }
+            day = cal.nextWorkdayDay(day);
+        }
+    }
+
+    // **Function to count the working minutes between two epoch minute times**
+    template <typename CalendarT, typename WorkHoursT>
+    long long BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkingMinutesBetween(std::int64_t from, std::int64_t to) {
+        //check the incoming times, calendar and work hours are valid
+        if (!TimeUtils::isValidEpochMinutes(from) || !TimeUtils::isValidEpochMinutes(to)) {
+            Logger::getInstance().logInfo("Invalid time", LOG_LOCATION);
+            return -1;
+        }
+        if (!hasCalendar()) {
+            Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+            return -1;
+        }
+        CalendarT& cal = calendar();
+        bool masks = false;
+        if constexpr (requires { cal.hasMinuteMasks(); }) {
+            masks = cal.hasMinuteMasks();
+        }
+        if (!masks && !work_hours_.isSet()) {
+            Logger::getInstance().logInfo("Invalid work hours", LOG_LOCATION);
+            return -1;
+        }
+        if (to <= from) {
+            return 0;
+        }
+        return countWorkedMinutes(work_hours_, from, to);
+    }
+
+    // **Partial first and last day from their windows, the whole days between from one count**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    long long BasicWorkdayCalendar<CalendarT, WorkHoursT>::countWorkedMinutes(const HoursT& hours, std::int64_t from,
+        std::int64_t to) {
+        CalendarT& cal = calendar();
+        if constexpr (requires { cal.hasMinuteMasks(); }) {
+            if (cal.hasMinuteMasks()) {
+                // The masks are only reachable through their increment: bisect on the minutes that end by 'to'
+                int from_day = 0;
+                int from_minute = 0;
+                TimeUtils::splitEpochMinutes(from, from_day, from_minute);
+                long long low = 0;
+                long long high = to - from;
+                while (low < high) {
+                    const long long middle = low + (high - low + 1) / 2;
+                    int day = from_day;
+                    int minuteOfDay = from_minute;
+                    if (cal.advanceWorkingMinutes(day, minuteOfDay, middle) && TimeUtils::joinEpochMinutes(day, minuteOfDay) <= to) {
+                        low = middle;
+                    }
+                    else {
+                        high = middle - 1;
+                    }
+                }
+                return low;
+            }
+        }
+
+        // Overnight shifts are counted on times shifted back by the shift start, as in incrementOvernight
+        const bool overnight = hours.isOvernight();
+        const int shift = overnight ? hours.getStartMinutes() : 0;
+        const int start = overnight ? 0 : hours.getStartMinutes();
+        const int stop = overnight ? hours.getDurationMinutes() : hours.getStopMinutes();
+        auto worked = [&](int day, int from_minute, int to_minute) -> long long {
+            int window_start = start;
+            int window_stop = stop;
+            bool own_window = false;
+            if constexpr (requires { cal.hasWindowOverrides(); }) {
+                own_window = !overnight && cal.getWindowOverride(day, window_start, window_stop);
+            }
+            if (!own_window && cal.isHolidayDay(day)) {
+                return 0;
+            }
+            return std::max(0, std::min(to_minute, window_stop) - std::max(from_minute, window_start));
+        };
+
+        int from_day = 0;
+        int from_minute = 0;
+        int to_day = 0;
+        int to_minute = 0;
+        TimeUtils::splitEpochMinutes(from - shift, from_day, from_minute);
+        TimeUtils::splitEpochMinutes(to - shift, to_day, to_minute);
+        if (from_day == to_day) {
+            return worked(from_day, from_minute, to_minute);
+        }
+        long long minutes = worked(from_day, from_minute, MINUTES_IN_DAY) + worked(to_day, 0, to_minute);
+        if (to_day > from_day + 1) {
+            // Overnight shifts ignore the per-date windows, so their whole days are all the same length
+            long long middle = -1;
+            if constexpr (requires { cal.countWorkingMinutes(from_day, to_day, stop); }) {
+                if (!overnight) {
+                    middle = cal.countWorkingMinutes(from_day + 1, to_day, stop - start);
+                }
+            }
+            if (middle < 0) {
+                middle = static_cast<long long>(cal.countWorkdaysDay(from_day + 1, to_day)) * (stop - start);
+            }
+            minutes += middle;
+        }
+        return minutes;
+    }
+
+    // **Function to calculate a date after incrementing by working minutes**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkingMinutesIncrement(const Date& startDate, long long workingMinutes) {
+        if (!checkStartDate(startDate)) {
+            // return invalid date
+            return startDate.generateInvalidDate();
+        }
+        return incrementValidDate(work_hours_, startDate, workingMinutes);
+    }
+
+    // **Function to calculate a date after incrementing by working minutes with per query work hours**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkingMinutesIncrement(const Date& startDate, long long workingMinutes,
+        const WorkHours& hours) {
+        if (!checkStartDate(startDate)) {
+            // return invalid date
+            return startDate.generateInvalidDate();
+        }
+        return incrementValidDate(hours, startDate, workingMinutes);
+    }
+
+    // **Function to calculate a date after incrementing by working minutes from a validated date**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkingMinutesIncrement(const ValidDate& startDate, long long workingMinutes) {
+        return incrementValidDate(work_hours_, startDate.getDate(), workingMinutes);
+    }
+
+    // **Function to calculate an epoch minute time after incrementing by working minutes**
+    template <typename CalendarT, typename WorkHoursT>
+    std::int64_t BasicWorkdayCalendar<CalendarT, WorkHoursT>::getEpochMinutesIncrement(std::int64_t epochMinutes, long long workingMinutes) {
+        return incrementEpochMinutes(work_hours_, epochMinutes, workingMinutes);
+    }
+
+    // **Function to apply one working minute increment to a column of epoch minute times**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::getEpochMinutesIncrements(std::span<const std::int64_t> epochMinutes,
+        long long workingMinutes, std::span<std::int64_t> results) {
+        for (std::size_t i = 0; i < epochMinutes.size() && i < results.size(); ++i) {
+            results[i] = incrementEpochMinutes(work_hours_, epochMinutes[i], workingMinutes);
+        }
+    }
+
+    // **Function to apply one working minute increment to a column of epoch minute times with per batch work hours**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::getEpochMinutesIncrements(std::span<const std::int64_t> epochMinutes,
+        long long workingMinutes, const WorkHours& hours, std::span<std::int64_t> results) {
+        for (std::size_t i = 0; i < epochMinutes.size() && i < results.size(); ++i) {
+            results[i] = incrementEpochMinutes(hours, epochMinutes[i], workingMinutes);
+        }
+    }
+
+    // **Splits the epoch minutes into day and minutes and joins them around the core**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    std::int64_t BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementEpochMinutes(const HoursT& hours,
+        std::int64_t epochMinutes, long long workingMinutes) {
+        //check the incoming time is valid
+        if (!TimeUtils::isValidEpochMinutes(epochMinutes)) {
+            Logger::getInstance().logInfo("Invalid start time", LOG_LOCATION);
+            return INVALID_EPOCH_MINUTES;
+        }
+
+        int day = 0;
+        int minuteOfDay = 0;
+        TimeUtils::splitEpochMinutes(epochMinutes, day, minuteOfDay);
+        if (!incrementDayAndMinutes(hours, day, minuteOfDay, workingMinutes)) {
+            return INVALID_EPOCH_MINUTES;
+        }
+        return TimeUtils::joinEpochMinutes(day, minuteOfDay);
+    }
+
+    // **Converts the validated date to day and minutes and back around the core**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementValidDate(const HoursT& hours, const Date& startDate,
+        long long workingMinutes) {
+        int day = TimeUtils::toDaySerial(startDate);
+        int minuteOfDay = TimeUtils::convertToMinutes(startDate.getTime());
+        if (!incrementDayAndMinutes(hours, day, minuteOfDay, workingMinutes)) {
+            // return invalid date
+            return startDate.generateInvalidDate();
+        }
+        Date current = startDate;
+        TimeUtils::setDaySerial(current, day);
+        TimeUtils::setMinutesOfDay(current, minuteOfDay);
+        return current;
+    }
+
+    // **Core of the increment on day serial and minutes of the day, the start is already validated**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    bool BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementDayAndMinutes(const HoursT& hours, int& day, int& minuteOfDay,
+        long long workingMinutes) {
+
+        try {
+            //check calendar valid
+            if (!hasCalendar()) {
+                Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+                return false;
+            }
+
+            CalendarT& cal = calendar();
+            // Calendars with minute masks replace the work hours altogether
+            if constexpr (requires { cal.hasMinuteMasks(); }) {
+                if (cal.hasMinuteMasks()) {
+                    return cal.advanceWorkingMinutes(day, minuteOfDay, workingMinutes);
+                }
+            }
+
+            //check workday start,stop and duration  are valid
+            if (!hours.isSet()) {
+                Logger::getInstance().logInfo("Invalid workday param", LOG_LOCATION);
+                return false;
+            }
+
+            //check the whole workdays of the increment fit the int day arithmetic; more than the days of the
+            //supported years cannot end on a valid date anyway
+            const long long max_workdays = TimeUtils::daysFromCivil(10000, 1, 1) - TimeUtils::daysFromCivil(0, 1, 1);
+            const long long workdays = workingMinutes / hours.getDurationMinutes();
+            if (workdays > max_workdays || workdays < -max_workdays) {
+                Logger::getInstance().logInfo("Increment out of range", LOG_LOCATION);
+                return false;
+            }
+
+            // Shifts running past midnight are handled on times measured from the shift start
+            if (hours.isOvernight()) {
+                incrementOvernight(hours, day, minuteOfDay, workingMinutes);
+                return true;
+            }
+
+            // Calendars with per-date working windows have uneven days
+            if constexpr (requires { cal.hasWindowOverrides(); }) {
+                if (cal.hasWindowOverrides()) {
+                    incrementWithWindows(hours, day, minuteOfDay, workingMinutes);
+                    return true;
+                }
+            }
+
+            incrementUniform(hours, day, minuteOfDay, workingMinutes);
+            return true;
+        }
+        catch (std::exception e) {
+            Logger::getInstance().logError(e.what(), LOG_LOCATION);
+            return false;
+        }
+    }
+
+    // **Moves over the whole workdays in one calendar call, then adds or removes the remaining minutes**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementUniform(const HoursT& hours, int& day, int& minuteOfDay,
+        long long workingMinutes) {
+        CalendarT& cal = calendar();
+        bool decrement = workingMinutes < 0;
+        // Check if increment is negative, handle decrement case separately
+        if (decrement) {
+            // Convert to positive value for calculation
+            workingMinutes = -workingMinutes;
+        }
+
+        const long long workdayInMinutes = hours.getDurationMinutes();
+
+        // Calculate number of workdays from the total increment
+        int workDays = static_cast<int>(workingMinutes / workdayInMinutes);
+
+        //move to first workday
+        if (cal.isHolidayDay(day)) {
+            if (decrement) {
+                day = cal.previousWorkdayDay(day);
+                minuteOfDay = hours.getStopMinutes();
+            }
+            else {
+                day = cal.nextWorkdayDay(day);
+                minuteOfDay = hours.getStartMinutes();
+            }
+        }
+
+        // Move over the whole workdays in a single calendar call
+        day = cal.advanceWorkdaysDay(day, decrement ? -workDays : workDays);
+
+        // Calculate remaining minutes after processing whole workdays
+        int remaining_minutes = static_cast<int>(workingMinutes % workdayInMinutes);
+        // Handle remaining minutes based on increment direction (add or remove)
+        if (decrement) {
+            removeRemainingMinutes(hours, remaining_minutes, day, minuteOfDay);
+        }
+        else {
+            addRemainingMinutes(hours, remaining_minutes, day, minuteOfDay);
+        }
+    }
+
+    // **Shifts the time back to the shift start, runs the same-day core and shifts the result forward again**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementOvernight(const HoursT& hours, int& day, int& minuteOfDay,
+        long long workingMinutes) {
+        const int shift_start = hours.getStartMinutes();
+        // Day of the shift the time belongs to, or follows, and the minutes since that shift started
+        TimeUtils::splitEpochMinutes(TimeUtils::joinEpochMinutes(day, minuteOfDay) - shift_start, day, minuteOfDay);
+        incrementUniform(WorkHours(0, hours.getDurationMinutes()), day, minuteOfDay, workingMinutes);
+        TimeUtils::splitEpochMinutes(TimeUtils::joinEpochMinutes(day, minuteOfDay) + shift_start, day, minuteOfDay);
+    }
+
+    // **Consumes the window of each day with its own window, jumping over the ordinary workdays in between**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementWithWindows(const HoursT& hours, int& day, int& minuteOfDay,
+        long long workingMinutes) {
+        CalendarT& cal = calendar();
+        const bool decrement = workingMinutes < 0;
+        long long remaining = decrement ? -workingMinutes : workingMinutes;
+        const int workday_minutes = hours.getDurationMinutes();
+
+        // Working window of a day, false if the day is not worked
+        int window_start = 0;
+        int window_stop = 0;
+        auto windowOf = [&](int windowDay) {
+            window_start = hours.getStartMinutes();
+            window_stop = hours.getStopMinutes();
+            return cal.getWindowOverride(windowDay, window_start, window_stop) || !cal.isHolidayDay(windowDay);
+        };
+
+        // Start as addRemainingMinutes and removeRemainingMinutes do: a time past the window (or before it when
+        // decrementing) and a day off move to the next window edge in the direction of travel
+        const bool worked = windowOf(day);
+        if (decrement) {
+            if (!worked || minuteOfDay < window_start) {
+                day = cal.previousWorkdayDay(day);
+                windowOf(day);
+                minuteOfDay = window_stop;
+            }
+            minuteOfDay = std::min(minuteOfDay, window_stop);
+        }
+        else {
+            if (!worked || minuteOfDay >= window_stop) {
+                day = cal.nextWorkdayDay(day);
+                windowOf(day);
+                minuteOfDay = window_start;
+            }
+            minuteOfDay = std::max(minuteOfDay, window_start);
+        }
+        // An increment ending exactly on a window edge lands on the edge of the same kind as the start: from a
+        // window start on the next start, from a window stop (decrementing) on the previous stop
+        const bool from_edge = minuteOfDay == (decrement ? window_stop : window_start);
+
+        while (true) {
+            const int available = decrement ? minuteOfDay - window_start : window_stop - minuteOfDay;
+            if (remaining < available || (remaining == available && !from_edge)) {
+                minuteOfDay += static_cast<int>(decrement ? -remaining : remaining);
+                return;
+            }
+            remaining -= available;
+            if (remaining == 0) {
+                day = decrement ? cal.previousWorkdayDay(day) : cal.nextWorkdayDay(day);
+                windowOf(day);
+                minuteOfDay = decrement ? window_stop : window_start;
+                return;
+            }
+
+            // Ordinary workdays up to the next day with its own window all have the same length
+            std::optional<int> window_day = decrement ? cal.previousOverrideDay(day) : cal.nextOverrideDay(day);
+            long long uniform_minutes = 0;
+            if (window_day) {
+                uniform_minutes = decrement
+                    ? cal.countWorkingMinutes(*window_day + 1, day, workday_minutes)
+                    : cal.countWorkingMinutes(day + 1, *window_day, workday_minutes);
+            }
+            if (!window_day || remaining <= uniform_minutes) {
+                // The target lies on an ordinary workday, select it directly
+                const long long days = (remaining + workday_minutes - 1) / workday_minutes;
+                day = cal.advanceWorkdaysDay(day, static_cast<int>(decrement ? -days : days));
+                remaining -= (days - 1) * workday_minutes;
+            }
+            else {
+                remaining -= uniform_minutes;
+                day = *window_day;
+            }
+            windowOf(day);
+            minuteOfDay = decrement ? window_stop : window_start;
+        }
+    }
+
+    // **Increments on local time, rerunning with the working minutes the crossed clock changes skipped or repeated**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    std::int64_t BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementUtcMinutes(const HoursT& hours,
+        std::int64_t utcMinutes, long long workingMinutes, const TimeZone& zone) {
+        //check the incoming time is valid
+        if (!TimeUtils::isValidEpochMinutes(utcMinutes)) {
+            Logger::getInstance().logInfo("Invalid start time", LOG_LOCATION);
+            return INVALID_EPOCH_MINUTES;
+        }
+
+        // Wall clock minutes to spend: the working minutes plus those the crossed changes skipped, less
+        // those they repeated. Each round recounts the changes between the start and the last result and
+        // reruns from the start; two rounds settle it in practice, a result still bouncing over a change
+        // after the cap is rejected rather than returned off by the change
+        const int max_rounds = 4;
+        const std::int64_t local_start = zone.toLocal(utcMinutes);
+        long long wall_minutes = workingMinutes;
+        for (int round = 0; round < max_rounds; ++round) {
+            int day = 0;
+            int minuteOfDay = 0;
+            TimeUtils::splitEpochMinutes(local_start, day, minuteOfDay);
+            if (!incrementDayAndMinutes(hours, day, minuteOfDay, wall_minutes)) {
+                return INVALID_EPOCH_MINUTES;
+            }
+            const std::int64_t result = zone.toUtc(TimeUtils::joinEpochMinutes(day, minuteOfDay));
+
+            const std::int64_t low = std::min(utcMinutes, result);
+            const std::int64_t high = std::max(utcMinutes, result);
+            long long skipped = 0;
+            for (std::size_t i = zone.firstTransitionAfter(low);
+                i < zone.getTransitionCount() && zone.getTransition(i) <= high; ++i) {
+                const int before = zone.getOffsetBefore(i);
+                const int after = zone.getOffsetAfter(i);
+                const std::int64_t wall = zone.getTransition(i) + before;
+                skipped += after > before ? workedWallMinutes(hours, wall, wall + after - before)
+                    : -workedWallMinutes(hours, wall + after - before, wall);
+            }
+            const long long corrected = workingMinutes + (workingMinutes >= 0 ? skipped : -skipped);
+            if (corrected == wall_minutes) {
+                return result;
+            }
+            wall_minutes = corrected;
+        }
+        Logger::getInstance().logInfo("Daylight saving correction did not settle", LOG_LOCATION);
+        return INVALID_EPOCH_MINUTES;
+    }
+
+    // **Overlaps the wall clock minutes of each day with the working window of that day**
+    template <typename CalendarT, typename WorkHoursT>
+    template <typename HoursT>
+    long long BasicWorkdayCalendar<CalendarT, WorkHoursT>::workedWallMinutes(const HoursT& hours,
+        std::int64_t localFrom, std::int64_t localTo) {
+        CalendarT& cal = calendar();
+        if constexpr (requires { cal.hasMinuteMasks(); }) {
+            if (cal.hasMinuteMasks()) {
+                return 0;
+            }
+        }
+
+        long long worked = 0;
+        while (localFrom < localTo) {
+            int day = 0;
+            int from = 0;
+            TimeUtils::splitEpochMinutes(localFrom, day, from);
+            const int to = static_cast<int>(std::min<std::int64_t>(localTo - TimeUtils::joinEpochMinutes(day, 0),
+                MINUTES_IN_DAY));
+            auto overlap = [from, to](int start, int stop) {
+                return std::max(0, std::min(to, stop) - std::max(from, start));
+            };
+
+            int window_start = hours.getStartMinutes();
+            int window_stop = hours.getStopMinutes();
+            bool own_window = false;
+            if constexpr (requires { cal.hasWindowOverrides(); }) {
+                own_window = !hours.isOvernight() && cal.getWindowOverride(day, window_start, window_stop);
+            }
+            if (hours.isOvernight()) {
+                // Tonight's shift from the start on, last night's shift until the stop
+                worked += cal.isHolidayDay(day) ? 0 : overlap(window_start, MINUTES_IN_DAY);
+                worked += cal.isHolidayDay(day - 1) ? 0 : overlap(0, window_stop);
+            }
+            else if (own_window || !cal.isHolidayDay(day)) {
+                worked += overlap(window_start, window_stop);
+            }
+            localFrom = TimeUtils::joinEpochMinutes(day, to);
+        }
+        return worked;
+    }
+
+    // **Function to calculate a date after incrementing by working minutes on a weekly schedule**
+    template <typename CalendarT, typename WorkHoursT>
+    Date BasicWorkdayCalendar<CalendarT, WorkHoursT>::getWorkingMinutesIncrement(const Date& startDate, long long workingMinutes,
+        const WeeklySchedule& schedule) {
+        if (!checkStartDate(startDate)) {
+            // return invalid date
+            return startDate.generateInvalidDate();
+        }
+
+        int day = TimeUtils::toDaySerial(startDate);
+        int minuteOfDay = TimeUtils::convertToMinutes(startDate.getTime());
+        if (!incrementOnSchedule(schedule, day, minuteOfDay, workingMinutes)) {
+            // return invalid date
+            return startDate.generateInvalidDate();
+        }
+        Date current = startDate;
+        TimeUtils::setDaySerial(current, day);
+        TimeUtils::setMinutesOfDay(current, minuteOfDay);
+        return current;
+    }
+
+    // **Function to apply one working minute increment on a weekly schedule to a column of epoch minute times**
+    template <typename CalendarT, typename WorkHoursT>
+    void BasicWorkdayCalendar<CalendarT, WorkHoursT>::getEpochMinutesIncrements(std::span<const std::int64_t> epochMinutes,
+        long long workingMinutes, const WeeklySchedule& schedule, std::span<std::int64_t> results) {
+        for (std::size_t i = 0; i < epochMinutes.size() && i < results.size(); ++i) {
+            //check the incoming time is valid
+            if (!TimeUtils::isValidEpochMinutes(epochMinutes[i])) {
+                Logger::getInstance().logInfo("Invalid start time", LOG_LOCATION);
+                results[i] = INVALID_EPOCH_MINUTES;
+                continue;
+            }
+            int day = 0;
+            int minuteOfDay = 0;
+            TimeUtils::splitEpochMinutes(epochMinutes[i], day, minuteOfDay);
+            results[i] = incrementOnSchedule(schedule, day, minuteOfDay, workingMinutes)
+                ? TimeUtils::joinEpochMinutes(day, minuteOfDay) : INVALID_EPOCH_MINUTES;
+        }
+    }
+
+    // **Walks the partial days on the schedule's cumulative table, skipping the whole weeks between them**
+    template <typename CalendarT, typename WorkHoursT>
+    bool BasicWorkdayCalendar<CalendarT, WorkHoursT>::incrementOnSchedule(const WeeklySchedule& schedule, int& day,
+        int& minuteOfDay, long long workingMinutes) {
+
+        try {
+            //check calendar valid
+            if (!hasCalendar()) {
+                Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+                return false;
+            }
+
+            //check the schedule has working time
+            if (schedule.getWeeklyMinutes() == 0) {
+                Logger::getInstance().logInfo("Invalid schedule", LOG_LOCATION);
+                return false;
+            }
+
+            CalendarT& cal = calendar();
+            const bool decrement = workingMinutes < 0;
+            long long remaining = decrement ? -workingMinutes : workingMinutes;
+            if (remaining == 0) {
+                return true;
+            }
+
+            // Give up after a year of workdays without any scheduled time, e.g. a schedule that only
+            // works on days the calendar has as weekend
+            const int max_idle_days = 366;
+            int idle_days = 0;
+            // Weeks skipped in one calendar call, keeps the day serials far from overflowing
+            const long long max_skipped_weeks = 520;
+            while (true) {
+                const int weekday = TimeUtils::weekdayFromDays(day);
+                const int daily = cal.isHolidayDay(day) ? 0 : schedule.getWorkingMinutes(weekday);
+                if (daily > 0) {
+                    idle_days = 0;
+                    const int worked = schedule.workedBefore(weekday, minuteOfDay);
+                    if (decrement) {
+                        // Working minutes of the day before the current time
+                        if (remaining <= worked) {
+                            minuteOfDay = schedule.minuteBeforeRemaining(weekday, worked - static_cast<int>(remaining));
+                            return true;
+                        }
+                        remaining -= worked;
+                    }
+                    else {
+                        // Working minutes of the day from the current time on
+                        if (remaining <= daily - worked) {
+                            minuteOfDay = schedule.minuteAfterWorked(weekday, worked + static_cast<int>(remaining));
+                            if (minuteOfDay == MINUTES_IN_DAY) {
+                                // Shift ending at midnight, report it as 00:00 of the next day
+                                ++day;
+                                minuteOfDay = 0;
+                            }
+                            return true;
+                        }
+                        remaining -= daily - worked;
+                    }
+                }
+                else if (++idle_days > max_idle_days) {
+                    Logger::getInstance().logInfo("Schedule has no working time on workdays", LOG_LOCATION);
+                    return false;
+                }
+
+                // No week works more than the weekly total, so skipping fewer whole weeks than the remaining
+                // minutes fill keeps the target ahead; the calendar counts what the skipped weeks really work
+                const long long weeks = std::min(max_skipped_weeks, (remaining - 1) / schedule.getWeeklyMinutes());
+                if (weeks > 0) {
+                    const int span = static_cast<int>(weeks) * DAYS_IN_WEEK;
+                    const int from = decrement ? day - span : day + 1;
+                    const long long skipped = cal.countWeekdayMinutes(from, from + span, schedule.getDailyMinutes());
+                    if (skipped > 0) {
+                        idle_days = 0;
+                    }
+                    else if ((idle_days += cal.countWorkdaysDay(from, from + span)) > max_idle_days) {
+                        Logger::getInstance().logInfo("Schedule has no working time on workdays", LOG_LOCATION);
+                        return false;
+                    }
+                    remaining -= skipped;
+                    day = decrement ? from : from + span - 1;
+                }
+
+                if (decrement) {
+                    day = cal.previousWorkdayDay(day);
+                    minuteOfDay = MINUTES_IN_DAY;
+                }
+                else {
+                    day = cal.nextWorkdayDay(day);
+                    minuteOfDay = 0;
+                }
+            }
+        }
+        catch (std::exception e) {
+            Logger::getInstance().logError(e.what(), LOG_LOCATION);
+            return false;
+        }
+    }
+
+} // namespace Workday
+
+#endif // BASIC_WORKDAY_CALENDAR_H
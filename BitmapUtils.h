@@ -0,0 +1,171 @@
+/**
+ * @file BitmapUtils.h
+ * @brief Header file for the Workday::BitmapUtils class, providing rank/select helpers over bitmaps.
+ *
+ * The bitmaps are stored as 64-bit words (bit i of the bitmap is bit i % 64 of word i / 64) together
+ * with a prefix count array holding the number of set bits before each word. All helpers are
+ * constexpr, so they can be used both on runtime indexes and on bitmaps generated at compile time.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef BITMAP_UTILS_H
+#define BITMAP_UTILS_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+
+namespace Workday {
+
+    const int BITS_IN_WORD = 64;
+
+    /**
+     * @class BitmapUtils
+     * @brief Provides rank, select and scan functions over word bitmaps with prefix counts.
+     */
+    class BitmapUtils {
+    public:
+        /**
+         * @brief Returns the number of words needed to hold the given number of bits.
+         * @param bits The number of bits.
+         * @return The number of 64-bit words.
+         */
+        static constexpr int wordCount(int bits) {
+            return (bits + BITS_IN_WORD - 1) / BITS_IN_WORD;
+        }
+
+        /**
+         * @brief Checks whether a bit is set.
+         * @param words The bitmap words.
+         * @param bit The bit position.
+         * @return True if the bit is set.
+         */
+        static constexpr bool testBit(std::span<const std::uint64_t> words, int bit) {
+            return (words[bit / BITS_IN_WORD] >> (bit % BITS_IN_WORD)) & 1u;
+        }
+
+        /**
+         * @brief Sets or clears a bit.
+         * @param words The bitmap words.
+         * @param bit The bit position.
+         * @param value The new bit value.
+         */
+        static constexpr void setBit(std::span<std::uint64_t> words, int bit, bool value) {
+            const std::uint64_t mask = std::uint64_t{ 1 } << (bit % BITS_IN_WORD);
+            if (value) {
+                words[bit / BITS_IN_WORD] |= mask;
+            }
+            else {
+                words[bit / BITS_IN_WORD] &= ~mask;
+            }
+        }
+
+        /**
+         * @brief Fills the prefix counts for the given words.
+         * @param words The bitmap words.
+         * @param prefix Output, must hold words.size() + 1 entries; prefix[i] is the number of set bits
+         * in words [0, i).
+         */
+        static constexpr void buildPrefixCounts(std::span<const std::uint64_t> words, std::span<int> prefix) {
+            prefix[0] = 0;
+            for (std::size_t i = 0; i < words.size(); ++i) {
+                prefix[i + 1] = prefix[i] + std::popcount(words[i]);
+            }
+        }
+
+        /**
+         * @brief Counts the set bits before a position.
+         * @param words The bitmap words.
+         * @param prefix The prefix counts of the words.
+         * @param bit The position, in [0, words.size() * 64].
+         * @return The number of set bits in [0, bit).
+         */
+        static constexpr int rank(std::span<const std::uint64_t> words, std::span<const int> prefix, int bit) {
+            const int word = bit / BITS_IN_WORD;
+            const int offset = bit % BITS_IN_WORD;
+            if (offset == 0) {
+                return prefix[word];
+            }
+            return prefix[word] + std::popcount(words[word] & ((std::uint64_t{ 1 } << offset) - 1));
+        }
+
+        /**
+         * @brief Finds the position of the k-th set bit (0-based). Logarithmic in the number of words:
+         * a binary search over the prefix counts, then at most 63 steps inside the word found.
+         * @param words The bitmap words.
+         * @param prefix The prefix counts of the words.
+         * @param k The rank of the bit to find.
+         * @return The position of the bit, or -1 if the bitmap has fewer than k + 1 set bits.
+         */
+        static constexpr int select(std::span<const std::uint64_t> words, std::span<const int> prefix, int k) {
+            if (k < 0 || k >= prefix[words.size()]) {
+                return -1;
+            }
+            // First word whose prefix count exceeds k holds the bit
+            const auto it = std::upper_bound(prefix.begin(), prefix.end(), k);
+            const int word = static_cast<int>(it - prefix.begin()) - 1;
+            std::uint64_t bits = words[word];
+            for (int skip = k - prefix[word]; skip > 0; --skip) {
+                bits &= bits - 1; // clear the lowest set bit
+            }
+            return word * BITS_IN_WORD + std::countr_zero(bits);
+        }
+
+        /**
+         * @brief Finds the first set bit at or after a position.
+         * @param words The bitmap words.
+         * @param bit The position to start from.
+         * @return The position of the set bit, or -1 if there is none.
+         */
+        static constexpr int nextSetBit(std::span<const std::uint64_t> words, int bit) {
+            if (bit < 0) {
+                bit = 0;
+            }
+            int word = bit / BITS_IN_WORD;
+            if (word >= static_cast<int>(words.size())) {
+                return -1;
+            }
+            std::uint64_t bits = words[word] & (~std::uint64_t{ 0 } << (bit % BITS_IN_WORD));
+            while (bits == 0) {
+                if (++word >= static_cast<int>(words.size())) {
+                    return -1;
+                }
+                bits = words[word];
+            }
+            return word * BITS_IN_WORD + std::countr_zero(bits);
+        }
+
+        /**
+         * @brief Finds the last set bit at or before a position.
+         * @param words The bitmap words.
+         * @param bit The position to start from.
+         * @return The position of the set bit, or -1 if there is none.
+         */
+        static constexpr int previousSetBit(std::span<const std::uint64_t> words, int bit) {
+            if (bit < 0 || words.empty()) {
+                return -1;
+            }
+            int word = bit / BITS_IN_WORD;
+            if (word >= static_cast<int>(words.size())) {
+                word = static_cast<int>(words.size()) - 1;
+                bit = word * BITS_IN_WORD + BITS_IN_WORD - 1;
+            }
+            std::uint64_t bits = words[word] & (~std::uint64_t{ 0 } >> (BITS_IN_WORD - 1 - bit % BITS_IN_WORD));
+            while (bits == 0) {
+                if (--word < 0) {
+                    return -1;
+                }
+                bits = words[word];
+            }
+            return word * BITS_IN_WORD + BITS_IN_WORD - 1 - std::countl_zero(bits);
+        }
+    };
+
+} // namespace Workday
+
+#endif // BITMAP_UTILS_H
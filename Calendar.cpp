@@ -12,5 +12,154 @@
  */
 
 #include "Calendar.h"
+#include "BitmapUtils.h"
+#include "TimeUtils.h"
+#include "logger.h"
 
- // Implementation of Calendar class methods goes here
+namespace Workday {
+
+    // **Steps forward one day at a time until a workday is reached**
+    void Calendar::nextWorkday(Date& date) const {
+        do {
+            addDay(date);
+        } while (isHoliday(date));
+    }
+
+    // **Steps backward one day at a time until a workday is reached**
+    void Calendar::previousWorkday(Date& date) const {
+        do {
+            removeDay(date);
+        } while (isHoliday(date));
+    }
+
+    // **Repeats nextWorkday / previousWorkday for each workday**
+    void Calendar::advanceWorkdays(Date& date, int workdays) const {
+        for (; workdays > 0; --workdays) {
+            nextWorkday(date);
+        }
+        for (; workdays < 0; ++workdays) {
+            previousWorkday(date);
+        }
+    }
+
+    // **Walks the range day by day and counts the non-holidays**
+    int Calendar::countWorkdays(const Date& from, const Date& to) const {
+        int days = TimeUtils::toDaySerial(to) - TimeUtils::toDaySerial(from);
+        int count = 0;
+        Date current = from;
+        for (int i = 0; i < days; ++i) {
+            if (!isHoliday(current)) {
+                ++count;
+            }
+            addDay(current);
+        }
+        return count;
+    }
+
+    // **Walks the range day by day and sets a bit per holiday**
+    void Calendar::fillHolidayMask(const Date& from, const Date& to, std::vector<std::uint64_t>& out) const {
+        int days = TimeUtils::toDaySerial(to) - TimeUtils::toDaySerial(from);
+        if (days < 0) {
+            days = 0;
+        }
+        out.assign(BitmapUtils::wordCount(days), 0);
+        Date current = from;
+        for (int i = 0; i < days; ++i) {
+            if (isHoliday(current)) {
+                out[i / BITS_IN_WORD] |= std::uint64_t{ 1 } << (i % BITS_IN_WORD);
+            }
+            addDay(current);
+        }
+    }
+
+    // **Checks a day serial through the Date based isHoliday**
+    bool Calendar::isHolidayDay(int day) const {
+        Date date;
+        TimeUtils::setDaySerial(date, day);
+        return isHoliday(date);
+    }
+
+    // **Finds the next workday through the Date based nextWorkday**
+    int Calendar::nextWorkdayDay(int day) const {
+        Date date;
+        TimeUtils::setDaySerial(date, day);
+        nextWorkday(date);
+        return TimeUtils::toDaySerial(date);
+    }
+
+    // **Finds the previous workday through the Date based previousWorkday**
+    int Calendar::previousWorkdayDay(int day) const {
+        Date date;
+        TimeUtils::setDaySerial(date, day);
+        previousWorkday(date);
+        return TimeUtils::toDaySerial(date);
+    }
+
+    // **Moves a day serial through the Date based advanceWorkdays**
+    int Calendar::advanceWorkdaysDay(int day, int workdays) const {
+        Date date;
+        TimeUtils::setDaySerial(date, day);
+        advanceWorkdays(date, workdays);
+        return TimeUtils::toDaySerial(date);
+    }
+
+    // **Counts the workdays through the Date based countWorkdays**
+    int Calendar::countWorkdaysDay(int from, int to) const {
+        Date from_date;
+        Date to_date;
+        TimeUtils::setDaySerial(from_date, from);
+        TimeUtils::setDaySerial(to_date, to);
+        return countWorkdays(from_date, to_date);
+    }
+
+    // **No per-date windows by default**
+    void Calendar::setWorkingWindow(const Date& /*date*/, int /*startMinutes*/, int /*stopMinutes*/) {
+        Logger::getInstance().logInfo("Working windows not supported by this calendar", LOG_LOCATION);
+    }
+
+    // **No per-date windows by default**
+    bool Calendar::hasWindowOverrides() const {
+        return false;
+    }
+
+    // **No per-date windows by default**
+    bool Calendar::getWindowOverride(int /*day*/, int& /*startMinutes*/, int& /*stopMinutes*/) const {
+        return false;
+    }
+
+    // **No per-date windows by default**
+    std::optional<int> Calendar::nextOverrideDay(int /*day*/) const {
+        return std::nullopt;
+    }
+
+    // **No per-date windows by default**
+    std::optional<int> Calendar::previousOverrideDay(int /*day*/) const {
+        return std::nullopt;
+    }
+
+    // **Counts the workdays through the Date based countWorkdays**
+    long long Calendar::countWorkingMinutes(int from, int to, int workdayMinutes) const {
+        Date from_date;
+        Date to_date;
+        TimeUtils::setDaySerial(from_date, from);
+        TimeUtils::setDaySerial(to_date, to);
+        return static_cast<long long>(countWorkdays(from_date, to_date)) * workdayMinutes;
+    }
+
+    // **Adds up the minutes of the weekday of each workday**
+    long long Calendar::countWeekdayMinutes(int from, int to, const std::array<int, DAYS_IN_WEEK>& weekdayMinutes) const {
+        long long minutes = 0;
+        for (int day = from; day < to; ++day) {
+            if (!isHolidayDay(day)) {
+                minutes += weekdayMinutes[TimeUtils::weekdayFromDays(day)];
+            }
+        }
+        return minutes;
+    }
+
+    // **No minute masks by default**
+    bool Calendar::advanceWorkingMinutes(int& /*day*/, int& /*minuteOfDay*/, long long /*workingMinutes*/) const {
+        return false;
+    }
+
+} // namespace Workday
@@ -14,6 +14,11 @@
 #define CALENDAR_H
 
 #include "Date.h"
+#include "TimeUtils.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
 
 namespace Workday {
     class Calendar {
@@ -109,6 +114,182 @@ namespace Workday {
          */
         virtual bool isValidDate(const Date& date) const = 0;
 
+        /**
+         * @brief Moves the given date to the first workday after it.
+         * The default implementation steps with addDay until isHoliday is false.
+         *
+         * @param date The date to move; its time is kept.
+         */
+        virtual void nextWorkday(Date& date) const;
+
+        /**
+         * @brief Moves the given date to the last workday before it.
+         * The default implementation steps with removeDay until isHoliday is false.
+         *
+         * @param date The date to move; its time is kept.
+         */
+        virtual void previousWorkday(Date& date) const;
+
+        /**
+         * @brief Moves the given date by a number of workdays.
+         * Equivalent to calling nextWorkday (or previousWorkday for a negative count) that many times.
+         *
+         * @param date The date to move; its time is kept.
+         * @param workdays The number of workdays to move, negative to move backwards.
+         */
+        virtual void advanceWorkdays(Date& date, int workdays) const;
+
+        /**
+         * @brief Counts the workdays in the half-open range [from, to), ignoring the time of day.
+         *
+         * @param from The first day of the range.
+         * @param to The day after the last day of the range.
+         * @return The number of workdays, zero if to is not after from.
+         */
+        virtual int countWorkdays(const Date& from, const Date& to) const;
+
+        /**
+         * @brief Fills a bit mask of the holidays in the half-open range [from, to).
+         * Bit i % 64 of out[i / 64] is set when the i-th day of the range is a holiday.
+         *
+         * @param from The first day of the range.
+         * @param to The day after the last day of the range.
+         * @param out The mask words, resized to fit the range.
+         */
+        virtual void fillHolidayMask(const Date& from, const Date& to, std::vector<std::uint64_t>& out) const;
+
+        /**
+         * @brief Checks if the day with the given serial is a holiday.
+         * The default implementation builds a Date and calls isHoliday.
+         *
+         * @param day The day serial (days since 1970-01-01).
+         * @return True if the day is a holiday, otherwise false.
+         */
+        virtual bool isHolidayDay(int day) const;
+
+        /**
+         * @brief Returns the first workday after the given day serial.
+         * The default implementation builds a Date and calls nextWorkday.
+         *
+         * @param day The day serial.
+         * @return The day serial of the workday.
+         */
+        virtual int nextWorkdayDay(int day) const;
+
+        /**
+         * @brief Returns the last workday before the given day serial.
+         * The default implementation builds a Date and calls previousWorkday.
+         *
+         * @param day The day serial.
+         * @return The day serial of the workday.
+         */
+        virtual int previousWorkdayDay(int day) const;
+
+        /**
+         * @brief Moves a day serial by a number of workdays.
+         * The default implementation builds a Date and calls advanceWorkdays.
+         *
+         * @param day The day serial.
+         * @param workdays The number of workdays to move, negative to move backwards.
+         * @return The day serial reached.
+         */
+        virtual int advanceWorkdaysDay(int day, int workdays) const;
+
+        /**
+         * @brief Counts the workdays in the day serials [from, to).
+         * The default implementation builds Dates and calls countWorkdays.
+         *
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @return The number of workdays, zero if to is not after from.
+         */
+        virtual int countWorkdaysDay(int from, int to) const;
+
+        /**
+         * @brief Gives a date its own working window, making it a workday even on a weekend or holiday.
+         * The default implementation ignores the request.
+         *
+         * @param date The date, its time is ignored.
+         * @param startMinutes Start of the window in minutes since midnight.
+         * @param stopMinutes Stop of the window in minutes since midnight.
+         */
+        virtual void setWorkingWindow(const Date& date, int startMinutes, int stopMinutes);
+
+        /**
+         * @brief Returns true if any day has its own working window.
+         * The default implementation has none.
+         */
+        virtual bool hasWindowOverrides() const;
+
+        /**
+         * @brief Looks up the working window of a day that has its own.
+         *
+         * @param day The day serial.
+         * @param startMinutes Output, start of the window in minutes since midnight.
+         * @param stopMinutes Output, stop of the window in minutes since midnight.
+         * @return True if the day has its own window; the outputs are left untouched otherwise.
+         */
+        virtual bool getWindowOverride(int day, int& startMinutes, int& stopMinutes) const;
+
+        /**
+         * @brief Finds the first day after the given one that has its own working window.
+         *
+         * @param day The day serial.
+         * @return The day serial, or nothing if there is none.
+         */
+        virtual std::optional<int> nextOverrideDay(int day) const;
+
+        /**
+         * @brief Finds the last day before the given one that has its own working window.
+         *
+         * @param day The day serial.
+         * @return The day serial, or nothing if there is none.
+         */
+        virtual std::optional<int> previousOverrideDay(int day) const;
+
+        /**
+         * @brief Counts the working minutes of the day serials in [from, to). Workdays count
+         * workdayMinutes each, days with their own working window count the length of that window.
+         * The default implementation multiplies countWorkdays by workdayMinutes.
+         *
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @param workdayMinutes The working minutes of an ordinary workday.
+         * @return The number of working minutes, zero if to is not after from.
+         */
+        virtual long long countWorkingMinutes(int from, int to, int workdayMinutes) const;
+
+        /**
+         * @brief Counts the working minutes of the day serials in [from, to) when each workday counts
+         * the minutes of its weekday. Days with their own working window count as ordinary workdays.
+         * The default implementation checks the days one by one with isHolidayDay.
+         *
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @param weekdayMinutes The working minutes of each weekday, indexed by weekday.
+         * @return The number of working minutes, zero if to is not after from.
+         */
+        virtual long long countWeekdayMinutes(int from, int to, const std::array<int, DAYS_IN_WEEK>& weekdayMinutes) const;
+
+        /**
+         * @brief Returns true if the calendar keeps its working time in minutes and moves times itself
+         * through advanceWorkingMinutes, instead of using work hours.
+         */
+        virtual bool hasMinuteMasks() const {
+            return false;
+        }
+
+        /**
+         * @brief Moves a time by a number of working minutes, for calendars with minute masks.
+         * The default implementation does nothing and returns false.
+         *
+         * @param day The day serial, updated to the resulting day.
+         * @param minuteOfDay The time in minutes since midnight, updated to the resulting time.
+         * @param workingMinutes The number of working minutes, negative to move backwards.
+         * @return True if the time was moved.
+         */
+        virtual bool advanceWorkingMinutes(int& day, int& minuteOfDay, long long workingMinutes) const;
+
         /**
          * @brief Virtual destructor.
          * Destructor to ensure proper cleanup when deleting subclasses.
@@ -0,0 +1,29 @@
+/**
+ * @file CalendarPeriod.h
+ * @brief Header file for the Workday::CalendarPeriod enumeration, the periods of the period-relative
+ * workday queries.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef CALENDAR_PERIOD_H
+#define CALENDAR_PERIOD_H
+
+namespace Workday {
+
+    /**
+     * @enum CalendarPeriod
+     * @brief A civil period containing a day: its month, its quarter or its year.
+     */
+    enum class CalendarPeriod {
+        Month,   ///< The calendar month
+        Quarter, ///< January-March, April-June, July-September or October-December
+        Year     ///< The calendar year
+    };
+
+} // namespace Workday
+
+#endif // CALENDAR_PERIOD_H
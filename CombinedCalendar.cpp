@@ -0,0 +1,217 @@
+/**
+ * @file CombinedCalendar.cpp
+ * @brief Implementation file for the CombinedCalendar class, the union or intersection of calendars.
+ *
+ * This file contains the compilation of the combined index from the sources' indexes and the
+ * day arithmetic on it, with the sources evaluated directly outside the indexed years.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "CombinedCalendar.h"
+#include "logger.h"
+#include <algorithm>
+
+namespace Workday {
+
+    // **Intersection - workdays in every calendar**
+    CombinedCalendar CombinedCalendar::intersectionOf(std::vector<GregorianCalendar> calendars) {
+        return CombinedCalendar(std::move(calendars), true);
+    }
+
+    // **Union - workdays in at least one calendar**
+    CombinedCalendar CombinedCalendar::unionOf(std::vector<GregorianCalendar> calendars) {
+        return CombinedCalendar(std::move(calendars), false);
+    }
+
+    // **Constructor - combines the sources' indexes over the years they all cover**
+    CombinedCalendar::CombinedCalendar(std::vector<GregorianCalendar> calendars, bool intersection)
+        : Calendar(), calendars_(std::move(calendars)), intersection_(intersection),
+        holidays_(), recurring_holidays_(), index_() {
+        if (calendars_.empty()) {
+            Logger::getInstance().logInfo("No calendars to combine, using a default calendar", LOG_LOCATION);
+            calendars_.emplace_back();
+        }
+
+        int first_day = calendars_.front().getIndex().getFirstDay();
+        int end_day = calendars_.front().getIndex().getEndDay();
+        for (const GregorianCalendar& calendar : calendars_) {
+            if (calendar.getIndex().empty()) {
+                return; // no common indexed years, the sources answer every day
+            }
+            first_day = std::max(first_day, calendar.getIndex().getFirstDay());
+            end_day = std::min(end_day, calendar.getIndex().getEndDay());
+        }
+        if (end_day <= first_day) {
+            return;
+        }
+
+        // Start from all ones for the intersection and all zeros for the union
+        index_ = WorkdayIndex(first_day, end_day - first_day);
+        if (intersection_) {
+            for (int day = first_day; day < end_day; ++day) {
+                index_.setWorkday(day, true);
+            }
+        }
+        for (const GregorianCalendar& calendar : calendars_) {
+            if (intersection_) {
+                index_.intersectWith(calendar.getIndex());
+            }
+            else {
+                index_.uniteWith(calendar.getIndex());
+            }
+        }
+        index_.updatePrefixCounts();
+    }
+
+    // **Adds a one-time holiday by storing its day serial and clearing it in the index**
+    void CombinedCalendar::setHoliday(const Date& date) {
+        if (isValidDate(date)) {
+            int day = TimeUtils::toDaySerial(date);
+            holidays_.insert(day);
+            if (index_.contains(day)) {
+                index_.setWorkday(day, false);
+                index_.updatePrefixCounts();
+            }
+        }
+    }
+
+    // **Adds a recurring holiday by storing month and day as a pair and clearing it in the index**
+    void CombinedCalendar::setRecurringHoliday(const Date& date) {
+        if (isValidDate(date)) {
+            recurring_holidays_.insert(std::make_pair(date.getMonth(), date.getDay()));
+            clearRecurringHoliday(date.getMonth(), date.getDay());
+            index_.updatePrefixCounts();
+        }
+    }
+
+    // **Clears a month/day pair in every indexed year**
+    void CombinedCalendar::clearRecurringHoliday(int month, int day) {
+        if (index_.empty()) {
+            return;
+        }
+        int first_year = std::get<0>(TimeUtils::civilFromDays(index_.getFirstDay()));
+        int last_year = std::get<0>(TimeUtils::civilFromDays(index_.getEndDay() - 1));
+        for (int year = first_year; year <= last_year; ++year) {
+            if (day > TimeUtils::daysInMonth(year, month)) {
+                continue; // Feb 29 outside leap years
+            }
+            int serial = TimeUtils::daysFromCivil(year, month, day);
+            if (index_.contains(serial)) {
+                index_.setWorkday(serial, false);
+            }
+        }
+    }
+
+    // **Own holidays first, then any (intersection) or every (union) source having the day off**
+    bool CombinedCalendar::isHolidayBySources(int day) const {
+        if (holidays_.count(day) > 0) {
+            return true;
+        }
+        if (!recurring_holidays_.empty()) {
+            const auto [year, month, month_day] = TimeUtils::civilFromDays(day);
+            if (recurring_holidays_.count(std::make_pair(month, month_day)) > 0) {
+                return true;
+            }
+        }
+        auto off = [day](const GregorianCalendar& calendar) { return calendar.isHolidayDay(day); };
+        return intersection_ ? std::any_of(calendars_.begin(), calendars_.end(), off)
+            : std::all_of(calendars_.begin(), calendars_.end(), off);
+    }
+
+    // **Looks the day up in the index, falling back to the sources**
+    bool CombinedCalendar::isHoliday(const Date& date) const {
+        return isHolidayDay(TimeUtils::toDaySerial(date));
+    }
+
+    // **Validates year, month, day, hour, and minute ranges**
+    bool CombinedCalendar::isValidDate(const Date& date) const {
+        return TimeUtils::isValidDate(date);
+    }
+
+    // **Moves to the next day serial**
+    void CombinedCalendar::addDay(Date& date_i) const {
+        TimeUtils::setDaySerial(date_i, TimeUtils::toDaySerial(date_i) + 1);
+    }
+
+    // **Moves to the previous day serial**
+    void CombinedCalendar::removeDay(Date& date_i) const {
+        TimeUtils::setDaySerial(date_i, TimeUtils::toDaySerial(date_i) - 1);
+    }
+
+    // **Next workday from the index, stepping day by day outside of it**
+    int CombinedCalendar::nextWorkdayDay(int day) const {
+        if (std::optional<int> next = index_.nextWorkday(day)) {
+            return *next;
+        }
+        do {
+            ++day;
+        } while (isHolidayDay(day));
+        return day;
+    }
+
+    // **Previous workday from the index, stepping day by day outside of it**
+    int CombinedCalendar::previousWorkdayDay(int day) const {
+        if (std::optional<int> previous = index_.previousWorkday(day)) {
+            return *previous;
+        }
+        do {
+            --day;
+        } while (isHolidayDay(day));
+        return day;
+    }
+
+    // **Moves to the next workday**
+    void CombinedCalendar::nextWorkday(Date& date) const {
+        TimeUtils::setDaySerial(date, nextWorkdayDay(TimeUtils::toDaySerial(date)));
+    }
+
+    // **Moves to the previous workday**
+    void CombinedCalendar::previousWorkday(Date& date) const {
+        TimeUtils::setDaySerial(date, previousWorkdayDay(TimeUtils::toDaySerial(date)));
+    }
+
+    // **Moves by a number of workdays**
+    void CombinedCalendar::advanceWorkdays(Date& date, int workdays) const {
+        TimeUtils::setDaySerial(date, advanceWorkdaysDay(TimeUtils::toDaySerial(date), workdays));
+    }
+
+    // **Selects the target workday in the index, stepping when it leaves the indexed years**
+    int CombinedCalendar::advanceWorkdaysDay(int day, int workdays) const {
+        if (std::optional<int> target = index_.advanceWorkdays(day, workdays)) {
+            return *target;
+        }
+        for (; workdays > 0; --workdays) {
+            day = nextWorkdayDay(day);
+        }
+        for (; workdays < 0; ++workdays) {
+            day = previousWorkdayDay(day);
+        }
+        return day;
+    }
+
+    // **Counts the workdays between the day serials of the dates**
+    int CombinedCalendar::countWorkdays(const Date& from, const Date& to) const {
+        return countWorkdaysDay(TimeUtils::toDaySerial(from), TimeUtils::toDaySerial(to));
+    }
+
+    // **Counts indexed days by prefix subtraction and the rest from the sources**
+    int CombinedCalendar::countWorkdaysDay(int from_day, int to_day) const {
+        if (to_day <= from_day) {
+            return 0;
+        }
+        int count = index_.countWorkdays(from_day, to_day);
+        // Days before and after the indexed years
+        for (int day = from_day; day < std::min(to_day, index_.getFirstDay()); ++day) {
+            count += !isHolidayBySources(day);
+        }
+        for (int day = std::max(from_day, index_.getEndDay()); day < to_day; ++day) {
+            count += !isHolidayBySources(day);
+        }
+        return count;
+    }
+
+} // namespace Workday
@@ -0,0 +1,200 @@
+/**
+ * @file CombinedCalendar.h
+ * @brief Header file for the Workday::CombinedCalendar class, the union or intersection of calendars.
+ *
+ * Cross-border work needs "a working day in both Germany and the US" (intersection) or "a working
+ * day in either" (union). The combined calendar is compiled once: the workday indexes of the
+ * GregorianCalendar instances are AND-ed or OR-ed word by word and the prefix counts recomputed,
+ * so its queries cost the same as those of a single calendar. Days outside the years all sources
+ * index are evaluated on copies of the sources, which are called directly rather than through
+ * Calendar.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef COMBINED_CALENDAR_H
+#define COMBINED_CALENDAR_H
+
+#include "Calendar.h"
+#include "GregorianCalendar.h"
+#include "TimeUtils.h"
+#include "WorkdayIndex.h"
+#include <set>
+#include <vector>
+
+namespace Workday {
+
+    /**
+     * @class CombinedCalendar
+     * @brief Calendar whose workdays are the union or the intersection of the workdays of other calendars.
+     *
+     * The sources are copied when the calendar is built; later changes to them are not seen. Holidays
+     * set on the combined calendar apply on top of the combination. The sources' working windows only
+     * count through the workdays they create.
+     */
+    class CombinedCalendar final : public Calendar {
+    public:
+        /**
+         * @brief Builds the calendar of the days that are workdays in every given calendar.
+         * @param calendars The calendars to combine.
+         * @return The combined calendar.
+         */
+        static CombinedCalendar intersectionOf(std::vector<GregorianCalendar> calendars);
+
+        /**
+         * @brief Builds the calendar of the days that are workdays in at least one given calendar.
+         * @param calendars The calendars to combine.
+         * @return The combined calendar.
+         */
+        static CombinedCalendar unionOf(std::vector<GregorianCalendar> calendars);
+
+        /**
+         * @brief Sets a holiday on the specified date, on top of the combination.
+         * @param date The date to set as a holiday.
+         */
+        void setHoliday(const Date& date) override;
+
+        /**
+         * @brief Sets a recurring holiday on the specified date, on top of the combination.
+         * @param date The date to set as a recurring holiday.
+         */
+        void setRecurringHoliday(const Date& date) override;
+
+        /**
+         * @brief Checks if the specified date is a holiday.
+         * @param date The date to check.
+         * @return True if the date is a holiday, false otherwise.
+         */
+        bool isHoliday(const Date& date) const override;
+
+        /**
+         * @brief Checks if the specified date is valid.
+         * @param date The date to check.
+         * @return True if the date is valid, false otherwise.
+         */
+        bool isValidDate(const Date& date) const override;
+
+        /**
+         * @brief Adds a day to the specified date.
+         * @param date_i The date to add a day to.
+         */
+        void addDay(Date& date_i) const override;
+
+        /**
+         * @brief Removes a day from the specified date.
+         * @param date_i The date to remove a day from.
+         */
+        void removeDay(Date& date_i) const override;
+
+        /**
+         * @brief Moves the date to the first workday after it.
+         * @param date The date to move.
+         */
+        void nextWorkday(Date& date) const override;
+
+        /**
+         * @brief Moves the date to the last workday before it.
+         * @param date The date to move.
+         */
+        void previousWorkday(Date& date) const override;
+
+        /**
+         * @brief Moves the date by a number of workdays.
+         * @param date The date to move.
+         * @param workdays The number of workdays, negative to move backwards.
+         */
+        void advanceWorkdays(Date& date, int workdays) const override;
+
+        /**
+         * @brief Counts the workdays in [from, to).
+         * @param from The first day of the range.
+         * @param to The day after the last day of the range.
+         * @return The number of workdays.
+         */
+        int countWorkdays(const Date& from, const Date& to) const override;
+
+        /**
+         * @brief Returns the compiled workday index.
+         */
+        const WorkdayIndex& getIndex() const {
+            return index_;
+        }
+
+        /**
+         * @brief Checks if the day with the given serial is a holiday.
+         * @param day The day serial (days since 1970-01-01).
+         * @return True if the day is not a workday of the combination.
+         */
+        bool isHolidayDay(int day) const override {
+            if (index_.contains(day)) {
+                return !index_.isWorkday(day);
+            }
+            return isHolidayBySources(day);
+        }
+
+        /**
+         * @brief Returns the first workday after the given day serial.
+         * @param day The day serial.
+         * @return The day serial of the workday.
+         */
+        int nextWorkdayDay(int day) const override;
+
+        /**
+         * @brief Returns the last workday before the given day serial.
+         * @param day The day serial.
+         * @return The day serial of the workday.
+         */
+        int previousWorkdayDay(int day) const override;
+
+        /**
+         * @brief Moves a day serial by a number of workdays.
+         * @param day The day serial.
+         * @param workdays The number of workdays, negative to move backwards.
+         * @return The day serial reached.
+         */
+        int advanceWorkdaysDay(int day, int workdays) const override;
+
+        /**
+         * @brief Counts the workdays in the day serials [from, to).
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @return The number of workdays, zero if to is not after from.
+         */
+        int countWorkdaysDay(int from, int to) const override;
+
+    private:
+        /**
+         * @brief Constructor, compiles the index of the combination.
+         * @param calendars The calendars to combine.
+         * @param intersection True for the intersection, false for the union.
+         */
+        CombinedCalendar(std::vector<GregorianCalendar> calendars, bool intersection);
+
+        /**
+         * @brief Evaluates a day outside the index on the sources and the own holidays.
+         * @param day The day serial.
+         * @return True if the day is a holiday.
+         */
+        bool isHolidayBySources(int day) const;
+
+        /**
+         * @brief Marks a recurring month/day as non-working in every indexed year.
+         * The caller updates the prefix counts afterwards.
+         * @param month The month of the recurring holiday.
+         * @param day The day of the recurring holiday.
+         */
+        void clearRecurringHoliday(int month, int day);
+
+        std::vector<GregorianCalendar> calendars_; /**< Copies of the combined calendars. */
+        bool intersection_; /**< True for the intersection, false for the union. */
+        std::set<int> holidays_; /**< Own one-time holidays, as day serials. */
+        std::set<std::pair<int, int>> recurring_holidays_; /**< Own recurring holidays. */
+        WorkdayIndex index_; /**< Combined workdays of the years every source indexes. */
+    };
+
+} // namespace Workday
+
+#endif // COMBINED_CALENDAR_H
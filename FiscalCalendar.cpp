@@ -0,0 +1,143 @@
+/**
+ * @file FiscalCalendar.cpp
+ * @brief Implementation file for the FiscalCalendar class, 52-53 week fiscal years split into
+ * 4-4-5 style periods.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "FiscalCalendar.h"
+#include "TimeUtils.h"
+#include "logger.h"
+#include <algorithm>
+
+namespace Workday {
+
+    // **Constructor - lays the weeks of every fiscal year into periods and counts their workdays**
+    FiscalCalendar::FiscalCalendar(const GregorianCalendar& calendar, int endMonth, int endWeekday, FiscalYearEnd yearEnd,
+        FiscalPattern pattern, int firstYear, int lastYear)
+        : calendar_(calendar), first_year_(firstYear), year_starts_(), period_starts_(), period_workdays_(),
+        week_periods_() {
+        if (endMonth < 1 || endMonth > 12 || endWeekday < SUNDAY || endWeekday > SATURDAY || lastYear < firstYear) {
+            Logger::getInstance().logInfo("Invalid fiscal year rule", LOG_LOCATION);
+            return;
+        }
+
+        const std::array<int, 3> quarter_weeks = pattern == FiscalPattern::Weeks445 ? std::array<int, 3>{ 4, 4, 5 }
+            : pattern == FiscalPattern::Weeks454 ? std::array<int, 3>{ 4, 5, 4 } : std::array<int, 3>{ 5, 4, 4 };
+        int week = 0;
+        for (int period = 0; period < FISCAL_PERIODS_IN_YEAR; ++period) {
+            for (int i = 0; i < quarter_weeks[period % 3]; ++i) {
+                week_periods_[week++] = period;
+            }
+        }
+        // The 53rd week of a long year belongs to the last period
+        week_periods_[week] = FISCAL_PERIODS_IN_YEAR - 1;
+
+        const int years = lastYear - firstYear + 1;
+        year_starts_.reserve(years + 1);
+        period_starts_.reserve(years * FISCAL_PERIODS_IN_YEAR + 1);
+        period_workdays_.reserve(years * FISCAL_PERIODS_IN_YEAR);
+        for (int year = firstYear; year <= lastYear + 1; ++year) {
+            year_starts_.push_back(yearEndDay(year - 1, endMonth, endWeekday, yearEnd) + 1);
+        }
+        for (int index = 0; index < years; ++index) {
+            const int year_start = year_starts_[index];
+            const int weeks = (year_starts_[index + 1] - year_start) / DAYS_IN_WEEK;
+            for (int w = 0; w < weeks; ++w) {
+                if (w == 0 || week_periods_[w] != week_periods_[w - 1]) {
+                    period_starts_.push_back(year_start + w * DAYS_IN_WEEK);
+                }
+            }
+        }
+        period_starts_.push_back(year_starts_.back());
+        for (std::size_t period = 0; period + 1 < period_starts_.size(); ++period) {
+            period_workdays_.push_back(calendar_.countWorkdaysDay(period_starts_[period], period_starts_[period + 1]));
+        }
+    }
+
+    // **Last end weekday on or before the month end, moved a week on when the next one is nearer**
+    int FiscalCalendar::yearEndDay(int year, int endMonth, int endWeekday, FiscalYearEnd yearEnd) {
+        const int month_end = TimeUtils::daysFromCivil(year, endMonth, TimeUtils::daysInMonth(year, endMonth));
+        const int days_back = (TimeUtils::weekdayFromDays(month_end) - endWeekday + DAYS_IN_WEEK) % DAYS_IN_WEEK;
+        const int last = month_end - days_back;
+        if (yearEnd == FiscalYearEnd::NearestWeekday && days_back > 3) {
+            return last + DAYS_IN_WEEK;
+        }
+        return last;
+    }
+
+    // **Starts from the civil year of the day, a fiscal year is at most one civil year off**
+    int FiscalCalendar::yearIndexOfDay(int day) const {
+        if (year_starts_.size() < 2 || day < year_starts_.front() || day >= year_starts_.back()) {
+            return -1;
+        }
+        const auto [year, month, month_day] = TimeUtils::civilFromDays(day);
+        int index = std::clamp(year - first_year_, 0, static_cast<int>(year_starts_.size()) - 2);
+        while (day < year_starts_[index]) {
+            --index;
+        }
+        while (day >= year_starts_[index + 1]) {
+            ++index;
+        }
+        return index;
+    }
+
+    // **Reads the bounds and the workdays of a period from the tables**
+    FiscalPeriod FiscalCalendar::periodAt(int index) const {
+        const int period = index % FISCAL_PERIODS_IN_YEAR;
+        return FiscalPeriod{ first_year_ + index / FISCAL_PERIODS_IN_YEAR, period / 3 + 1, period + 1,
+            period_starts_[index], period_starts_[index + 1], period_workdays_[index] };
+    }
+
+    // **Finds the year, then the period of the day's week in that year**
+    std::optional<FiscalPeriod> FiscalCalendar::getPeriodOfDay(int day) const {
+        const int year_index = yearIndexOfDay(day);
+        if (year_index < 0) {
+            return std::nullopt;
+        }
+        const int week = (day - year_starts_[year_index]) / DAYS_IN_WEEK;
+        return periodAt(year_index * FISCAL_PERIODS_IN_YEAR + week_periods_[week]);
+    }
+
+    // **Validates the date and looks its day serial up**
+    std::optional<FiscalPeriod> FiscalCalendar::getPeriod(const Date& date) const {
+        if (!TimeUtils::isValidDate(date)) {
+            Logger::getInstance().logInfo("Invalid date", LOG_LOCATION);
+            return std::nullopt;
+        }
+        return getPeriodOfDay(TimeUtils::toDaySerial(date));
+    }
+
+    // **Indexes the tables by year and period**
+    std::optional<FiscalPeriod> FiscalCalendar::getPeriod(int fiscalYear, int period) const {
+        const int year_index = fiscalYear - first_year_;
+        if (year_starts_.size() < 2 || year_index < 0 || year_index >= static_cast<int>(year_starts_.size()) - 1 ||
+            period < 1 || period > FISCAL_PERIODS_IN_YEAR) {
+            return std::nullopt;
+        }
+        return periodAt(year_index * FISCAL_PERIODS_IN_YEAR + period - 1);
+    }
+
+    // **Period workdays less those before the date, both from tables**
+    int FiscalCalendar::getWorkdaysLeftInPeriod(const Date& date) const {
+        std::optional<FiscalPeriod> period = getPeriod(date);
+        if (!period) {
+            return -1;
+        }
+        return period->workdays - calendar_.countWorkdaysDay(period->firstDay, TimeUtils::toDaySerial(date));
+    }
+
+    // **Compares the year's length with 53 weeks**
+    bool FiscalCalendar::isLongYear(int fiscalYear) const {
+        const int year_index = fiscalYear - first_year_;
+        if (year_starts_.size() < 2 || year_index < 0 || year_index >= static_cast<int>(year_starts_.size()) - 1) {
+            return false;
+        }
+        return year_starts_[year_index + 1] - year_starts_[year_index] == FISCAL_WEEKS_IN_LONG_YEAR * DAYS_IN_WEEK;
+    }
+
+} // namespace Workday
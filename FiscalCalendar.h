@@ -0,0 +1,155 @@
+/**
+ * @file FiscalCalendar.h
+ * @brief Header file for the Workday::FiscalCalendar class, 52-53 week fiscal years split into
+ * 4-4-5 style periods.
+ *
+ * A fiscal year ends on a fixed weekday, the last one of its end month or the one nearest to the end
+ * of that month, so it has 52 or 53 weeks. Each quarter has three periods of whole weeks (4-4-5,
+ * 4-5-4 or 5-4-4); the 53rd week goes to the last period. The period boundaries and the workdays
+ * of every period are computed once for a range of fiscal years against a GregorianCalendar, so
+ * finding the period of a day is a lookup of its year and of its week in that year.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef FISCAL_CALENDAR_H
+#define FISCAL_CALENDAR_H
+
+#include "Date.h"
+#include "GregorianCalendar.h"
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace Workday {
+
+    const int FISCAL_PERIODS_IN_YEAR = 12;
+    const int FISCAL_WEEKS_IN_LONG_YEAR = 53;
+
+    /**
+     * @enum FiscalYearEnd
+     * @brief Which end weekday closes the fiscal year.
+     */
+    enum class FiscalYearEnd {
+        LastWeekday,   ///< The last end weekday of the end month
+        NearestWeekday ///< The end weekday nearest to the last day of the end month
+    };
+
+    /**
+     * @enum FiscalPattern
+     * @brief Weeks of the three periods of each quarter.
+     */
+    enum class FiscalPattern {
+        Weeks445,
+        Weeks454,
+        Weeks544
+    };
+
+    /**
+     * @struct FiscalPeriod
+     * @brief A fiscal period, its bounds as day serials and its workdays.
+     */
+    struct FiscalPeriod {
+        int year;     ///< Fiscal year, the civil year it ends in
+        int quarter;  ///< Quarter, 1 to 4
+        int period;   ///< Period of the year, 1 to 12
+        int firstDay; ///< Day serial of the first day of the period
+        int endDay;   ///< Day serial one past the last day of the period
+        int workdays; ///< Workdays of the period
+    };
+
+    /**
+     * @class FiscalCalendar
+     * @brief Period tables of 52-53 week fiscal years over the workdays of a GregorianCalendar.
+     *
+     * The calendar is copied when the tables are built; holidays set on it later are not seen.
+     * Days outside the fiscal years of the tables have no period.
+     */
+    class FiscalCalendar {
+    public:
+        /**
+         * @brief Constructor, builds the period tables.
+         * @param calendar The calendar whose workdays are counted.
+         * @param endMonth The month the fiscal years end in, 1 to 12.
+         * @param endWeekday The weekday the fiscal years end on, SUNDAY (0) to SATURDAY (6).
+         * @param yearEnd Which end weekday closes the year.
+         * @param pattern The weeks of the periods of each quarter.
+         * @param firstYear The first fiscal year of the tables.
+         * @param lastYear The last fiscal year of the tables (inclusive).
+         */
+        FiscalCalendar(const GregorianCalendar& calendar, int endMonth, int endWeekday, FiscalYearEnd yearEnd,
+            FiscalPattern pattern, int firstYear, int lastYear);
+
+        /**
+         * @brief Returns the fiscal period containing a day.
+         * @param day The day serial.
+         * @return The period, or nothing outside the fiscal years of the tables.
+         */
+        std::optional<FiscalPeriod> getPeriodOfDay(int day) const;
+
+        /**
+         * @brief Returns the fiscal period containing a date.
+         * @param date The date, its time is ignored.
+         * @return The period, or nothing for an invalid date or outside the fiscal years of the tables.
+         */
+        std::optional<FiscalPeriod> getPeriod(const Date& date) const;
+
+        /**
+         * @brief Returns a period of a fiscal year.
+         * @param fiscalYear The fiscal year.
+         * @param period The period, 1 to 12.
+         * @return The period, or nothing outside the tables.
+         */
+        std::optional<FiscalPeriod> getPeriod(int fiscalYear, int period) const;
+
+        /**
+         * @brief Counts the workdays from a date, included, to the end of its fiscal period.
+         * @param date The date, its time is ignored.
+         * @return The number of workdays, or -1 for an invalid date or outside the tables.
+         */
+        int getWorkdaysLeftInPeriod(const Date& date) const;
+
+        /**
+         * @brief Checks if a fiscal year has 53 weeks.
+         * @param fiscalYear The fiscal year, within the tables.
+         */
+        bool isLongYear(int fiscalYear) const;
+
+        /**
+         * @brief Returns the day serial of the last day of a fiscal year.
+         * @param year The fiscal year.
+         * @param endMonth The month the fiscal years end in, 1 to 12.
+         * @param endWeekday The weekday the fiscal years end on, SUNDAY (0) to SATURDAY (6).
+         * @param yearEnd Which end weekday closes the year.
+         * @return The day serial.
+         */
+        static int yearEndDay(int year, int endMonth, int endWeekday, FiscalYearEnd yearEnd);
+
+    private:
+        /**
+         * @brief Finds the table index of the fiscal year containing a day.
+         * @param day The day serial.
+         * @return The index, or -1 outside the tables.
+         */
+        int yearIndexOfDay(int day) const;
+
+        /**
+         * @brief Builds the period of a table entry.
+         * @param index The index of the period in the tables.
+         */
+        FiscalPeriod periodAt(int index) const;
+
+        GregorianCalendar calendar_; ///< Copy of the calendar the workdays are counted on
+        int first_year_; ///< First fiscal year of the tables
+        std::vector<int> year_starts_; ///< First day of each fiscal year, and the day after the last one
+        std::vector<int> period_starts_; ///< First day of each period, and the day after the last one
+        std::vector<int> period_workdays_; ///< Workdays of each period
+        std::array<int, FISCAL_WEEKS_IN_LONG_YEAR> week_periods_; ///< Period of each week of a year, from 0
+    };
+
+} // namespace Workday
+
+#endif // FISCAL_CALENDAR_H
@@ -0,0 +1,98 @@
+/**
+ * @file FollowTheSun.cpp
+ * @brief Implementation file for the FollowTheSun class, computing deadlines of work handed over
+ * between regional teams.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "FollowTheSun.h"
+#include "TimeUtils.h"
+#include "logger.h"
+#include <algorithm>
+
+namespace Workday {
+
+    // **Runs a leg on the carried integers; an empty leg leaves the time where it is**
+    bool FollowTheSun::runLeg(WorkdayCalendar* calendar, int& day, int& minuteOfDay, long long workingMinutes) {
+        if (calendar == nullptr) {
+            Logger::getInstance().logInfo("Invalid calendar", LOG_LOCATION);
+            return false;
+        }
+        if (workingMinutes == 0) {
+            return true;
+        }
+        return calendar->advanceWorkingMinutes(day, minuteOfDay, workingMinutes);
+    }
+
+    // **Validates the start once, then carries day and minutes through the legs**
+    std::int64_t FollowTheSun::getChainedIncrement(std::int64_t epochMinutes, std::span<const HandoverLeg> legs) {
+        //check the incoming time is valid
+        if (!TimeUtils::isValidEpochMinutes(epochMinutes)) {
+            Logger::getInstance().logInfo("Invalid start time", LOG_LOCATION);
+            return INVALID_EPOCH_MINUTES;
+        }
+
+        int day = 0;
+        int minuteOfDay = 0;
+        TimeUtils::splitEpochMinutes(epochMinutes, day, minuteOfDay);
+        for (const HandoverLeg& leg : legs) {
+            if (!runLeg(leg.calendar, day, minuteOfDay, leg.workingMinutes)) {
+                return INVALID_EPOCH_MINUTES;
+            }
+        }
+        return TimeUtils::joinEpochMinutes(day, minuteOfDay);
+    }
+
+    // **Converts the date at both ends of the chain only**
+    Date FollowTheSun::getChainedIncrement(const Date& startDate, std::span<const HandoverLeg> legs) {
+        //check the incoming date is valid
+        if (!TimeUtils::isValidDate(startDate)) {
+            Logger::getInstance().logInfo("Invalid startdate", LOG_LOCATION);
+            return startDate.generateInvalidDate();
+        }
+
+        int day = TimeUtils::toDaySerial(startDate);
+        int minuteOfDay = TimeUtils::convertToMinutes(startDate.getTime());
+        for (const HandoverLeg& leg : legs) {
+            if (!runLeg(leg.calendar, day, minuteOfDay, leg.workingMinutes)) {
+                // return invalid date
+                return startDate.generateInvalidDate();
+            }
+        }
+        Date current = startDate;
+        TimeUtils::setDaySerial(current, day);
+        TimeUtils::setMinutesOfDay(current, minuteOfDay);
+        return current;
+    }
+
+    // **Hands the remaining minutes around the teams, one leg budget at a time**
+    std::int64_t FollowTheSun::getRotationIncrement(std::int64_t epochMinutes, std::span<WorkdayCalendar* const> teams,
+        long long minutesPerLeg, long long workingMinutes) {
+        //check the incoming time and the rotation are valid
+        if (!TimeUtils::isValidEpochMinutes(epochMinutes)) {
+            Logger::getInstance().logInfo("Invalid start time", LOG_LOCATION);
+            return INVALID_EPOCH_MINUTES;
+        }
+        if (teams.empty() || minutesPerLeg <= 0 || workingMinutes < 0) {
+            Logger::getInstance().logInfo("Invalid rotation", LOG_LOCATION);
+            return INVALID_EPOCH_MINUTES;
+        }
+
+        int day = 0;
+        int minuteOfDay = 0;
+        TimeUtils::splitEpochMinutes(epochMinutes, day, minuteOfDay);
+        for (std::size_t team = 0; workingMinutes > 0; team = (team + 1) % teams.size()) {
+            const long long leg_minutes = std::min(minutesPerLeg, workingMinutes);
+            if (!runLeg(teams[team], day, minuteOfDay, leg_minutes)) {
+                return INVALID_EPOCH_MINUTES;
+            }
+            workingMinutes -= leg_minutes;
+        }
+        return TimeUtils::joinEpochMinutes(day, minuteOfDay);
+    }
+
+} // namespace Workday
@@ -0,0 +1,85 @@
+/**
+ * @file FollowTheSun.h
+ * @brief Header file for the Workday::FollowTheSun class, computing deadlines of work handed over
+ * between regional teams.
+ *
+ * Each team has its own WorkdayCalendar with its hours and holidays. A chain is a sequence of legs,
+ * each spending a working minute budget on one team's calendar; the next leg starts where the
+ * previous one ended. The time is validated once and carried between the legs as a day serial and
+ * the minutes of that day, without going through Date in between.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef FOLLOW_THE_SUN_H
+#define FOLLOW_THE_SUN_H
+
+#include "Date.h"
+#include "WorkdayCalendar.h"
+#include <cstdint>
+#include <span>
+
+namespace Workday {
+
+    /**
+     * @struct HandoverLeg
+     * @brief One leg of a chain: a team's calendar and the working minutes it spends.
+     */
+    struct HandoverLeg {
+        WorkdayCalendar* calendar; ///< Calendar of the team working the leg
+        long long workingMinutes;  ///< Working minutes spent on the leg, negative to go backwards
+    };
+
+    /**
+     * @class FollowTheSun
+     * @brief Provides chained working minute increments across several workday calendars.
+     */
+    class FollowTheSun {
+    public:
+        /**
+         * @brief Calculates the end of a chain of legs, each leg starting where the previous one ended.
+         * @param epochMinutes The start time in minutes since the epoch.
+         * @param legs The legs, in order.
+         * @return The end time in minutes since the epoch, or INVALID_EPOCH_MINUTES if anything goes wrong.
+         */
+        static std::int64_t getChainedIncrement(std::int64_t epochMinutes, std::span<const HandoverLeg> legs);
+
+        /**
+         * @brief Calculates the end of a chain of legs, each leg starting where the previous one ended.
+         * @param startDate The start date.
+         * @param legs The legs, in order.
+         * @return The end date, or invalid date if anything goes wrong.
+         */
+        static Date getChainedIncrement(const Date& startDate, std::span<const HandoverLeg> legs);
+
+        /**
+         * @brief Calculates the end of work handed around a rotation of teams: each team in turn spends up
+         * to minutesPerLeg working minutes, starting again with the first team after the last, until the
+         * total is spent.
+         * @param epochMinutes The start time in minutes since the epoch.
+         * @param teams The calendars of the teams, in hand over order.
+         * @param minutesPerLeg The working minutes each team spends before handing over, positive.
+         * @param workingMinutes The total working minutes, not negative.
+         * @return The end time in minutes since the epoch, or INVALID_EPOCH_MINUTES if anything goes wrong.
+         */
+        static std::int64_t getRotationIncrement(std::int64_t epochMinutes, std::span<WorkdayCalendar* const> teams,
+            long long minutesPerLeg, long long workingMinutes);
+
+    private:
+        /**
+         * @brief Runs one leg on the carried day serial and minutes of the day.
+         * @param calendar The team's calendar.
+         * @param day The day serial, updated to the end of the leg.
+         * @param minuteOfDay The minutes of the day, updated to the end of the leg.
+         * @param workingMinutes The working minutes of the leg.
+         * @return True on success.
+         */
+        static bool runLeg(WorkdayCalendar* calendar, int& day, int& minuteOfDay, long long workingMinutes);
+    };
+
+} // namespace Workday
+
+#endif // FOLLOW_THE_SUN_H
@@ -0,0 +1,170 @@
+/**
+ * @file Generator.h
+ * @brief Header file for the Workday::Generator class template, a minimal C++20 coroutine generator.
+ *
+ * C++20 has the coroutine machinery but not std::generator (C++23). Generator is the hand-rolled
+ * equivalent: a coroutine returning Generator<T> suspends at every co_yield, and the consumer pulls
+ * the values one by one through an input iterator, so an unbounded sequence is produced only as far
+ * as it is read. The generator is a move-only std::ranges::view and composes with std::views::take.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+namespace Workday {
+
+    /**
+     * @class Generator
+     * @brief Lazily produced sequence of values, backed by a coroutine.
+     *
+     * @tparam T The type of the yielded values.
+     */
+    template <typename T>
+    class Generator : public std::ranges::view_base {
+    public:
+        /**
+         * @struct promise_type
+         * @brief Coroutine promise, keeps the last yielded value.
+         */
+        struct promise_type {
+            std::optional<T> value; ///< Last yielded value
+            std::exception_ptr exception; ///< Exception escaping the coroutine, rethrown to the consumer
+
+            Generator get_return_object() {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always yield_value(T yielded) {
+                value = std::move(yielded);
+                return {};
+            }
+
+            void return_void() {
+            }
+
+            void unhandled_exception() {
+                exception = std::current_exception();
+            }
+        };
+
+        /**
+         * @class iterator
+         * @brief Input iterator resuming the coroutine on each increment.
+         */
+        class iterator {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(std::coroutine_handle<promise_type> handle)
+                : handle_(handle) {
+            }
+
+            const T& operator*() const {
+                return *handle_.promise().value;
+            }
+
+            iterator& operator++() {
+                resume(handle_);
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) {
+                return !it.handle_ || it.handle_.done();
+            }
+
+        private:
+            std::coroutine_handle<promise_type> handle_ = nullptr; ///< Coroutine producing the values
+        };
+
+        Generator() = default;
+
+        Generator(Generator&& other) noexcept
+            : handle_(std::exchange(other.handle_, nullptr)) {
+        }
+
+        Generator& operator=(Generator&& other) noexcept {
+            if (this != &other) {
+                destroy();
+                handle_ = std::exchange(other.handle_, nullptr);
+            }
+            return *this;
+        }
+
+        Generator(const Generator&) = delete;
+        Generator& operator=(const Generator&) = delete;
+
+        ~Generator() {
+            destroy();
+        }
+
+        /**
+         * @brief Runs the coroutine to its first value. Call once: the sequence can be read only once.
+         */
+        iterator begin() {
+            if (handle_) {
+                resume(handle_);
+            }
+            return iterator(handle_);
+        }
+
+        std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+    private:
+        explicit Generator(std::coroutine_handle<promise_type> handle)
+            : handle_(handle) {
+        }
+
+        /**
+         * @brief Resumes the coroutine to its next value, rethrowing what escaped it.
+         */
+        static void resume(std::coroutine_handle<promise_type> handle) {
+            handle.resume();
+            if (handle.promise().exception) {
+                std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+            }
+        }
+
+        void destroy() {
+            if (handle_) {
+                handle_.destroy();
+                handle_ = nullptr;
+            }
+        }
+
+        std::coroutine_handle<promise_type> handle_ = nullptr; ///< Owned coroutine
+    };
+
+} // namespace Workday
+
+#endif // GENERATOR_H
@@ -13,127 +13,294 @@
  */
 
 #include "GregorianCalendar.h"
+#include <algorithm>
+#include <iterator>
 
 namespace Workday {
 
-    // **Default constructor - calls base class constructor**
-    GregorianCalendar::GregorianCalendar() : Calendar() {}
+    // **Default constructor - calls base class constructor and compiles the default index**
+    GregorianCalendar::GregorianCalendar() : Calendar() {
+        compileIndex(DEFAULT_INDEX_FIRST_YEAR, DEFAULT_INDEX_LAST_YEAR);
+    }
 
     // **Constructor with specific date and time arguments**
     GregorianCalendar::GregorianCalendar(int year, int month, int day, int hour, int minute)
-        : Calendar(year, month, day, hour, minute) {}
+        : Calendar(year, month, day, hour, minute) {
+        compileIndex(DEFAULT_INDEX_FIRST_YEAR, DEFAULT_INDEX_LAST_YEAR);
+    }
 
-    // **Adds a one-time holiday by storing the date string**
+    // **Adds a one-time holiday by storing its day serial and clearing it in the index**
     void GregorianCalendar::setHoliday(const Date& date) {
         if (isValidDate(date)) {
-            holidays_.insert(date.getDate());
+            int day = TimeUtils::toDaySerial(date);
+            holidays_.insert(day);
+            if (index_.contains(day) && window_overrides_.count(day) == 0) {
+                index_.setWorkday(day, false);
+                index_.updatePrefixCounts();
+            }
         }
     }
 
-    // **Adds a recurring holiday by storing month and day as a pair**
+    // **Adds a recurring holiday by storing month and day as a pair and clearing it in the index**
     void GregorianCalendar::setRecurringHoliday(const Date& date) {
         if (isValidDate(date)) {
             recurring_holidays_.insert(std::make_pair(date.getMonth(), date.getDay()));
+            clearRecurringHoliday(date.getMonth(), date.getDay());
+            applyWindowOverrides();
+            index_.updatePrefixCounts();
+        }
+    }
+
+    // **Clears a month/day pair in every indexed year**
+    void GregorianCalendar::clearRecurringHoliday(int month, int day) {
+        if (index_.empty()) {
+            return;
+        }
+        int first_year = std::get<0>(TimeUtils::civilFromDays(index_.getFirstDay()));
+        int last_year = std::get<0>(TimeUtils::civilFromDays(index_.getEndDay() - 1));
+        for (int year = first_year; year <= last_year; ++year) {
+            if (day > TimeUtils::daysInMonth(year, month)) {
+                continue; // Feb 29 outside leap years
+            }
+            int serial = TimeUtils::daysFromCivil(year, month, day);
+            if (index_.contains(serial)) {
+                index_.setWorkday(serial, false);
+            }
+        }
+    }
+
+    // **Rebuilds the workday index: weekdays first, then the stored holidays cleared**
+    void GregorianCalendar::compileIndex(int firstYear, int lastYear) {
+        if (lastYear < firstYear) {
+            index_ = WorkdayIndex();
+            return;
+        }
+        int first_day = TimeUtils::daysFromCivil(firstYear, 1, 1);
+        int end_day = TimeUtils::daysFromCivil(lastYear + 1, 1, 1);
+        index_ = WorkdayIndex(first_day, end_day - first_day);
+        int day_of_week = TimeUtils::weekdayFromDays(first_day);
+        for (int day = first_day; day < end_day; ++day) {
+            index_.setWorkday(day, day_of_week != 0 && day_of_week != 6);
+            day_of_week = (day_of_week + 1) % 7;
+        }
+        for (int day : holidays_) {
+            if (index_.contains(day)) {
+                index_.setWorkday(day, false);
+            }
+        }
+        for (const auto& [month, day] : recurring_holidays_) {
+            clearRecurringHoliday(month, day);
+        }
+        applyWindowOverrides();
+        index_.updatePrefixCounts();
+    }
+
+    // **Own working windows win over weekends and holidays**
+    void GregorianCalendar::applyWindowOverrides() {
+        for (const auto& [day, window] : window_overrides_) {
+            if (index_.contains(day)) {
+                index_.setWorkday(day, true);
+                index_.setDayMinutes(day, window.second - window.first);
+            }
+        }
+    }
+
+    // **Stores the window by day serial and marks the day as a workday in the index**
+    void GregorianCalendar::setWorkingWindow(const Date& date, int startMinutes, int stopMinutes) {
+        if (isValidDate(date) && 0 <= startMinutes && startMinutes < stopMinutes && stopMinutes <= MINUTES_IN_DAY) {
+            window_overrides_[TimeUtils::toDaySerial(date)] = std::make_pair(startMinutes, stopMinutes);
+            applyWindowOverrides();
+            index_.updatePrefixCounts();
+        }
+    }
+
+    // **Looks the day up in the sparse window map**
+    bool GregorianCalendar::getWindowOverride(int day, int& startMinutes, int& stopMinutes) const {
+        auto it = window_overrides_.find(day);
+        if (it == window_overrides_.end()) {
+            return false;
         }
+        startMinutes = it->second.first;
+        stopMinutes = it->second.second;
+        return true;
     }
 
-    // **Checks for weekends, then one-time and recurring holidays**
-    bool GregorianCalendar::isHoliday(const Date& date) const {
-        int day_of_week = date.dayOfWeek();
-        // Check for Saturday (0) or Sunday (6)
+    // **First map entry after the day**
+    std::optional<int> GregorianCalendar::nextOverrideDay(int day) const {
+        auto it = window_overrides_.upper_bound(day);
+        if (it == window_overrides_.end()) {
+            return std::nullopt;
+        }
+        return it->first;
+    }
+
+    // **Last map entry before the day**
+    std::optional<int> GregorianCalendar::previousOverrideDay(int day) const {
+        auto it = window_overrides_.lower_bound(day);
+        if (it == window_overrides_.begin()) {
+            return std::nullopt;
+        }
+        return std::prev(it)->first;
+    }
+
+    // **Counts indexed days from the prefix sums and the rest day by day**
+    long long GregorianCalendar::countWorkingMinutes(int from, int to, int workdayMinutes) const {
+        if (to <= from) {
+            return 0;
+        }
+        long long minutes = index_.countWorkingMinutes(from, to, workdayMinutes);
+        // Days before and after the indexed years
+        auto outside = [&](int day) {
+            int start = 0;
+            int stop = 0;
+            if (getWindowOverride(day, start, stop)) {
+                return static_cast<long long>(stop - start);
+            }
+            return isHolidayByRules(day) ? 0LL : workdayMinutes;
+        };
+        for (int day = from; day < std::min(to, index_.getFirstDay()); ++day) {
+            minutes += outside(day);
+        }
+        for (int day = std::max(from, index_.getEndDay()); day < to; ++day) {
+            minutes += outside(day);
+        }
+        return minutes;
+    }
+
+    // **Counts indexed days by masked popcounts and the rest day by day**
+    long long GregorianCalendar::countWeekdayMinutes(int from, int to, const std::array<int, DAYS_IN_WEEK>& weekdayMinutes) const {
+        if (to <= from) {
+            return 0;
+        }
+        long long minutes = index_.countWeekdayMinutes(from, to, weekdayMinutes);
+        // Days before and after the indexed years
+        auto outside = [&](int day) {
+            return isHolidayByRules(day) ? 0LL : weekdayMinutes[TimeUtils::weekdayFromDays(day)];
+        };
+        for (int day = from; day < std::min(to, index_.getFirstDay()); ++day) {
+            minutes += outside(day);
+        }
+        for (int day = std::max(from, index_.getEndDay()); day < to; ++day) {
+            minutes += outside(day);
+        }
+        return minutes;
+    }
+
+    // **Checks own working windows, weekends, then one-time and recurring holidays**
+    bool GregorianCalendar::isHolidayByRules(int day) const {
+        // Days with their own working window are always worked
+        if (window_overrides_.count(day) > 0) {
+            return false;
+        }
+
+        int day_of_week = TimeUtils::weekdayFromDays(day);
+        // Check for Saturday (6) or Sunday (0)
         if (day_of_week == 0 || day_of_week == 6) {
             return true;
         }
 
         // Check for one-time holidays
-        if (holidays_.count(date.getDate()) > 0) {
+        if (holidays_.count(day) > 0) {
             return true;
         }
 
         // Check for recurring holidays
-        if (recurring_holidays_.count(std::make_pair(date.getMonth(), date.getDay())) > 0) {
-            return true;
+        if (!recurring_holidays_.empty()) {
+            const auto [year, month, month_day] = TimeUtils::civilFromDays(day);
+            if (recurring_holidays_.count(std::make_pair(month, month_day)) > 0) {
+                return true;
+            }
         }
         return false;
     }
 
-    // **Validates year, month, day, hour, and minute ranges**
-    bool GregorianCalendar::isValidDate(const Date& date) const {
-        int year = date.getYear();
-        int month = date.getMonth();
-        int day = date.getDay();
-        int hour = date.getHours();
-        int minute = date.getMinutes();
-
-        //checking for valid date
-        if (year < 0 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
-            return false;
+    // **Next workday from the index, stepping day by day outside of it**
+    int GregorianCalendar::nextWorkdayDay(int day) const {
+        if (std::optional<int> next = index_.nextWorkday(day)) {
+            return *next;
         }
+        do {
+            ++day;
+        } while (isHolidayDay(day));
+        return day;
+    }
 
-        //checking for valid time
-        if (hour < 0 || hour >= 24 || minute < 0 || minute >= 60) {
-            return false;
+    // **Previous workday from the index, stepping day by day outside of it**
+    int GregorianCalendar::previousWorkdayDay(int day) const {
+        if (std::optional<int> previous = index_.previousWorkday(day)) {
+            return *previous;
         }
+        do {
+            --day;
+        } while (isHolidayDay(day));
+        return day;
+    }
 
-        return true;
+    // **Moves to the next workday**
+    void GregorianCalendar::nextWorkday(Date& date) const {
+        TimeUtils::setDaySerial(date, nextWorkdayDay(TimeUtils::toDaySerial(date)));
     }
 
-    // **Standard Gregorian leap year check**
-    bool GregorianCalendar::isLeapYear(int year) const {
-        if (year % 4 != 0) return false;
-        if (year % 100 != 0) return true;
-        if (year % 400 == 0) return true;
-        return false;
+    // **Moves to the previous workday**
+    void GregorianCalendar::previousWorkday(Date& date) const {
+        TimeUtils::setDaySerial(date, previousWorkdayDay(TimeUtils::toDaySerial(date)));
     }
 
-    // **Calculates number of days in a month considering leap years**
-    int GregorianCalendar::daysInMonth(int year, int month) const {
-        switch (month) {
-        case 1: case 3: case 5: case 7: case 8: case 10: case 12:
-            return 31;
-        case 4: case 6: case 9: case 11:
-            return 30;
-        case 2:
-            return isLeapYear(year) ? 29 : 28;
-        default:
-            return 30;
-        }
-    }
-
-    // **Increments date (year, month, day) handling rollovers**
-    void GregorianCalendar::addDay(Date& date_i) const {
-        int newYear = date_i.getYear();
-        int newMonth = date_i.getMonth();
-        int newDay = date_i.getDay() + 1;
-
-        if (newDay > daysInMonth(newYear, newMonth)) {
-            newDay = 1;
-            newMonth++;
-            if (newMonth > 12) {
-                newMonth = 1;
-                newYear++;
-            }
+    // **Moves by a number of workdays**
+    void GregorianCalendar::advanceWorkdays(Date& date, int workdays) const {
+        TimeUtils::setDaySerial(date, advanceWorkdaysDay(TimeUtils::toDaySerial(date), workdays));
+    }
+
+    // **Selects the target workday in the index, stepping when it leaves the indexed years**
+    int GregorianCalendar::advanceWorkdaysDay(int day, int workdays) const {
+        if (std::optional<int> target = index_.advanceWorkdays(day, workdays)) {
+            return *target;
+        }
+        for (; workdays > 0; --workdays) {
+            day = nextWorkdayDay(day);
+        }
+        for (; workdays < 0; ++workdays) {
+            day = previousWorkdayDay(day);
         }
+        return day;
+    }
 
-        date_i.setDate(newYear, newMonth, newDay, date_i.getHours(), date_i.getMinutes());
+    // **Counts the workdays between the day serials of the dates**
+    int GregorianCalendar::countWorkdays(const Date& from, const Date& to) const {
+        return countWorkdaysDay(TimeUtils::toDaySerial(from), TimeUtils::toDaySerial(to));
     }
 
-    // **decrements date (year, month, day) handling rollovers**
-    void GregorianCalendar::removeDay(Date& date) const {
-        int newYear = date.getYear();
-        int newMonth = date.getMonth();
-        int newDay = date.getDay() - 1;
+    // **Counts indexed days by prefix subtraction and the rest from the rules**
+    int GregorianCalendar::countWorkdaysDay(int from_day, int to_day) const {
+        if (to_day <= from_day) {
+            return 0;
+        }
+        int count = index_.countWorkdays(from_day, to_day);
+        // Days before and after the indexed years
+        for (int day = from_day; day < std::min(to_day, index_.getFirstDay()); ++day) {
+            count += !isHolidayByRules(day);
+        }
+        for (int day = std::max(from_day, index_.getEndDay()); day < to_day; ++day) {
+            count += !isHolidayByRules(day);
+        }
+        return count;
+    }
 
-        if (newDay < 1) {
-            newMonth--;
-            if (newMonth < 1) {
-                newMonth = 12;
-                newYear--;
+    // **Sets a bit per holiday in the range**
+    void GregorianCalendar::fillHolidayMask(const Date& from, const Date& to, std::vector<std::uint64_t>& out) const {
+        int from_day = TimeUtils::toDaySerial(from);
+        int days = std::max(0, TimeUtils::toDaySerial(to) - from_day);
+        out.assign(BitmapUtils::wordCount(days), 0);
+        for (int i = 0; i < days; ++i) {
+            if (isHolidayDay(from_day + i)) {
+                out[i / BITS_IN_WORD] |= std::uint64_t{ 1 } << (i % BITS_IN_WORD);
             }
-            newDay = daysInMonth(newYear, newMonth);
         }
+    }
 
-        date.setDate(newYear, newMonth, newDay, date.getHours(), date.getMinutes());
+    // **Validates year, month, day, hour, and minute ranges**
+    bool GregorianCalendar::isValidDate(const Date& date) const {
+        return TimeUtils::isValidDate(date);
     }
 
 } // namespace Workday
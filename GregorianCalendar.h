@@ -16,15 +16,28 @@
 #define WORKDAY_GREGORIAN_CALENDAR_H
 
 #include "Calendar.h"
+#include "TimeUtils.h"
+#include "WorkdayIndex.h"
+#include <map>
 #include <set>
 
 namespace Workday {
 
+    // Years covered by the workday index compiled on construction
+    const int DEFAULT_INDEX_FIRST_YEAR = 1970;
+    const int DEFAULT_INDEX_LAST_YEAR = 2099;
+
     /**
      * @class GregorianCalendar
      * @brief Manages Gregorian calendar calculations including holidays and workdays.
+     *
+     * Workdays of the years [DEFAULT_INDEX_FIRST_YEAR, DEFAULT_INDEX_LAST_YEAR] (or the range passed
+     * to compileIndex) are kept in a WorkdayIndex that is updated as holidays are added, so the range
+     * operations run on the bitmap. Days outside the index are evaluated from the holiday rules.
+     * Single dates can get their own working window (early closes, working Saturdays); they count
+     * as workdays and their working minutes are kept in the index as well.
      */
-    class GregorianCalendar : public Calendar {
+    class GregorianCalendar final : public Calendar {
     public:
         /**
          * @brief Default constructor.
@@ -72,38 +85,237 @@ namespace Workday {
          */
         bool isValidDate(const Date& date) const override;
 
-    private:
-        std::set<std::string> holidays_; /**< Set of holiday dates. */
-        std::set<std::pair<int, int>> recurring_holidays_; /**< Set of recurring holiday dates. */
+        /**
+         * @brief Adds a day to the specified date, considering month and year transitions.
+         * @param date_i The date to add a day to.
+         */
+        void addDay(Date& date_i) const override;
+
+        /**
+         * @brief Removes a day from the specified date, considering month and year transitions.
+         * @param date The date to remove a day from.
+         */
+        void removeDay(Date& date) const override;
 
         /**
-         * @brief Checks if the specified year is a leap year.
-         * @param year The year to check.
-         * @return True if the year is a leap year, false otherwise.
+         * @brief Moves the date to the first workday after it.
+         * @param date The date to move.
          */
-        bool isLeapYear(int year) const;
+        void nextWorkday(Date& date) const override;
 
         /**
-         * @brief Returns the number of days in the specified month of the specified year.
-         * @param year The year.
-         * @param month The month.
-         * @return The number of days in the month.
+         * @brief Moves the date to the last workday before it.
+         * @param date The date to move.
          */
-        int daysInMonth(int year, int month) const;
+        void previousWorkday(Date& date) const override;
 
         /**
-         * @brief Adds a day to the specified date, considering month and year transitions.
-         * @param date_i The date to add a day to.
+         * @brief Moves the date by a number of workdays.
+         * @param date The date to move.
+         * @param workdays The number of workdays, negative to move backwards.
          */
-        void addDay(Date& date_i) const override;
+        void advanceWorkdays(Date& date, int workdays) const override;
 
         /**
-         * @brief Removes a day from the specified date, considering month and year transitions.
-         * @param date The date to remove a day from.
+         * @brief Counts the workdays in [from, to).
+         * @param from The first day of the range.
+         * @param to The day after the last day of the range.
+         * @return The number of workdays.
          */
-        void removeDay(Date& date) const override;
+        int countWorkdays(const Date& from, const Date& to) const override;
+
+        /**
+         * @brief Fills a bit mask of the holidays in [from, to).
+         * @param from The first day of the range.
+         * @param to The day after the last day of the range.
+         * @param out The mask words.
+         */
+        void fillHolidayMask(const Date& from, const Date& to, std::vector<std::uint64_t>& out) const override;
+
+        /**
+         * @brief Gives a date its own working window, making it a workday even on a weekend or holiday.
+         * @param date The date, its time is ignored.
+         * @param startMinutes Start of the window in minutes since midnight.
+         * @param stopMinutes Stop of the window in minutes since midnight.
+         */
+        void setWorkingWindow(const Date& date, int startMinutes, int stopMinutes) override;
+
+        /**
+         * @brief Returns true if any date has its own working window.
+         */
+        bool hasWindowOverrides() const override {
+            return !window_overrides_.empty();
+        }
+
+        /**
+         * @brief Looks up the working window of a day that has its own.
+         * @param day The day serial.
+         * @param startMinutes Output, start of the window.
+         * @param stopMinutes Output, stop of the window.
+         * @return True if the day has its own window.
+         */
+        bool getWindowOverride(int day, int& startMinutes, int& stopMinutes) const override;
+
+        /**
+         * @brief Finds the first day after the given one that has its own working window.
+         * @param day The day serial.
+         * @return The day serial, or nothing if there is none.
+         */
+        std::optional<int> nextOverrideDay(int day) const override;
+
+        /**
+         * @brief Finds the last day before the given one that has its own working window.
+         * @param day The day serial.
+         * @return The day serial, or nothing if there is none.
+         */
+        std::optional<int> previousOverrideDay(int day) const override;
+
+        /**
+         * @brief Counts the working minutes in [from, to).
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @param workdayMinutes The working minutes of an ordinary workday.
+         * @return The number of working minutes.
+         */
+        long long countWorkingMinutes(int from, int to, int workdayMinutes) const override;
+
+        /**
+         * @brief Counts the working minutes in [from, to), each workday counting the minutes of its weekday.
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @param weekdayMinutes The working minutes of each weekday.
+         * @return The number of working minutes.
+         */
+        long long countWeekdayMinutes(int from, int to, const std::array<int, DAYS_IN_WEEK>& weekdayMinutes) const override;
+
+        /**
+         * @brief Rebuilds the workday index to cover the given years.
+         * @param firstYear The first year covered.
+         * @param lastYear The last year covered (inclusive).
+         */
+        void compileIndex(int firstYear, int lastYear);
+
+        /**
+         * @brief Returns the compiled workday index.
+         */
+        const WorkdayIndex& getIndex() const {
+            return index_;
+        }
+
+        /**
+         * @brief Checks if the day with the given serial is a holiday.
+         * @param day The day serial (days since 1970-01-01).
+         * @return True if the day is a weekend day or a holiday.
+         */
+        bool isHolidayDay(int day) const override {
+            if (index_.contains(day)) {
+                return !index_.isWorkday(day);
+            }
+            return isHolidayByRules(day);
+        }
+
+        /**
+         * @brief Returns the first workday after the given day serial.
+         * @param day The day serial.
+         * @return The day serial of the workday.
+         */
+        int nextWorkdayDay(int day) const override;
+
+        /**
+         * @brief Returns the last workday before the given day serial.
+         * @param day The day serial.
+         * @return The day serial of the workday.
+         */
+        int previousWorkdayDay(int day) const override;
+
+        /**
+         * @brief Moves a day serial by a number of workdays.
+         * @param day The day serial.
+         * @param workdays The number of workdays, negative to move backwards.
+         * @return The day serial reached.
+         */
+        int advanceWorkdaysDay(int day, int workdays) const override;
+
+        /**
+         * @brief Counts the workdays in the day serials [from, to).
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @return The number of workdays, zero if to is not after from.
+         */
+        int countWorkdaysDay(int from, int to) const override;
+
+    private:
+        std::set<int> holidays_; /**< Set of holiday dates, as day serials. */
+        std::set<std::pair<int, int>> recurring_holidays_; /**< Set of recurring holiday dates. */
+        std::map<int, std::pair<int, int>> window_overrides_; /**< Own working windows (start, stop) by day serial. */
+        WorkdayIndex index_; /**< Compiled workdays of the indexed years. */
+
+        /**
+         * @brief Evaluates the weekend and holiday rules for a day, without the index.
+         * @param day The day serial.
+         * @return True if the day is a holiday.
+         */
+        bool isHolidayByRules(int day) const;
+
+        /**
+         * @brief Marks a recurring month/day as non-working in every indexed year.
+         * The caller updates the prefix counts afterwards.
+         * @param month The month of the recurring holiday.
+         * @param day The day of the recurring holiday.
+         */
+        void clearRecurringHoliday(int month, int day);
+
+        /**
+         * @brief Marks the days with their own working window as workdays in the index and stores
+         * their working minutes. The caller updates the prefix counts afterwards.
+         */
+        void applyWindowOverrides();
     };
 
+    // The day arithmetic below is defined inline so that callers bound to GregorianCalendar
+    // statically (see BasicWorkdayCalendar) can inline it into their increment loops.
+
+    // **Looks the day up in the index, falling back to the weekend and holiday rules**
+    inline bool GregorianCalendar::isHoliday(const Date& date) const {
+        return isHolidayDay(TimeUtils::toDaySerial(date));
+    }
+
+    // **Increments date (year, month, day) handling rollovers**
+    inline void GregorianCalendar::addDay(Date& date_i) const {
+        int newYear = date_i.getYear();
+        int newMonth = date_i.getMonth();
+        int newDay = date_i.getDay() + 1;
+
+        if (newDay > TimeUtils::daysInMonth(newYear, newMonth)) {
+            newDay = 1;
+            newMonth++;
+            if (newMonth > 12) {
+                newMonth = 1;
+                newYear++;
+            }
+        }
+
+        date_i.setDate(newYear, newMonth, newDay, date_i.getHours(), date_i.getMinutes());
+    }
+
+    // **decrements date (year, month, day) handling rollovers**
+    inline void GregorianCalendar::removeDay(Date& date) const {
+        int newYear = date.getYear();
+        int newMonth = date.getMonth();
+        int newDay = date.getDay() - 1;
+
+        if (newDay < 1) {
+            newMonth--;
+            if (newMonth < 1) {
+                newMonth = 12;
+                newYear--;
+            }
+            newDay = TimeUtils::daysInMonth(newYear, newMonth);
+        }
+
+        date.setDate(newYear, newMonth, newDay, date.getHours(), date.getMinutes());
+    }
+
 } // namespace Workday
 
 #endif // WORKDAY_GREGORIAN_CALENDAR_H
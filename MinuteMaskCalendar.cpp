@@ -0,0 +1,241 @@
+/**
+ * @file MinuteMaskCalendar.cpp
+ * @brief Implementation file for the MinuteMaskCalendar class, a calendar with minute resolution.
+ *
+ * This file contains the mask updates and the working minute arithmetic: rank and select inside a
+ * day, daily totals across days and whole-week jumps across runs of template days.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "MinuteMaskCalendar.h"
+#include "logger.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace Workday {
+
+    // **Sets or clears a range of bits, then rebuilds the prefix counts**
+    void MinuteMaskCalendar::DayMask::setRange(int startMinutes, int stopMinutes, bool available) {
+        for (int minute = startMinutes; minute < stopMinutes; ++minute) {
+            BitmapUtils::setBit(words, minute, available);
+        }
+        BitmapUtils::buildPrefixCounts(words, prefix);
+    }
+
+    // **Default constructor - no working minutes**
+    MinuteMaskCalendar::MinuteMaskCalendar()
+        : Calendar(), weekdays_(), dates_(), recurring_holidays_(), empty_(), weekly_minutes_(0) {}
+
+    // **Updates the weekday template and the weekly total**
+    void MinuteMaskCalendar::setWeekdayMinutes(int weekday, int startMinutes, int stopMinutes, bool available) {
+        if (weekday < SUNDAY || weekday > SATURDAY || startMinutes < 0 || startMinutes >= stopMinutes ||
+            stopMinutes > MINUTES_IN_DAY) {
+            Logger::getInstance().logInfo("Invalid weekday minutes", LOG_LOCATION);
+            return;
+        }
+        weekly_minutes_ -= weekdays_[weekday].total();
+        weekdays_[weekday].setRange(startMinutes, stopMinutes, available);
+        weekly_minutes_ += weekdays_[weekday].total();
+    }
+
+    // **Copies the current mask of the date on first change, then updates it**
+    void MinuteMaskCalendar::setDateMinutes(const Date& date, int startMinutes, int stopMinutes, bool available) {
+        if (!isValidDate(date) || startMinutes < 0 || startMinutes >= stopMinutes || stopMinutes > MINUTES_IN_DAY) {
+            Logger::getInstance().logInfo("Invalid date minutes", LOG_LOCATION);
+            return;
+        }
+        int day = TimeUtils::toDaySerial(date);
+        auto it = dates_.find(day);
+        if (it == dates_.end()) {
+            it = dates_.emplace(day, maskOf(day)).first;
+        }
+        it->second.setRange(startMinutes, stopMinutes, available);
+    }
+
+    // **Stores an empty mask for the date**
+    void MinuteMaskCalendar::setHoliday(const Date& date) {
+        if (isValidDate(date)) {
+            dates_[TimeUtils::toDaySerial(date)] = empty_;
+        }
+    }
+
+    // **Stores month and day as a pair**
+    void MinuteMaskCalendar::setRecurringHoliday(const Date& date) {
+        if (isValidDate(date)) {
+            recurring_holidays_.insert(std::make_pair(date.getMonth(), date.getDay()));
+        }
+    }
+
+    // **Moves to the next day serial**
+    void MinuteMaskCalendar::addDay(Date& date_i) const {
+        TimeUtils::setDaySerial(date_i, TimeUtils::toDaySerial(date_i) + 1);
+    }
+
+    // **Moves to the previous day serial**
+    void MinuteMaskCalendar::removeDay(Date& date_i) const {
+        TimeUtils::setDaySerial(date_i, TimeUtils::toDaySerial(date_i) - 1);
+    }
+
+    // **A day without working minutes is a holiday**
+    bool MinuteMaskCalendar::isHoliday(const Date& date) const {
+        return isHolidayDay(TimeUtils::toDaySerial(date));
+    }
+
+    // **Validates year, month, day, hour, and minute ranges**
+    bool MinuteMaskCalendar::isValidDate(const Date& date) const {
+        return TimeUtils::isValidDate(date);
+    }
+
+    // **Own mask first, then recurring holidays, then the weekday template**
+    const MinuteMaskCalendar::DayMask& MinuteMaskCalendar::maskOf(int day) const {
+        if (!dates_.empty()) {
+            auto it = dates_.find(day);
+            if (it != dates_.end()) {
+                return it->second;
+            }
+        }
+        if (isRecurringHoliday(day)) {
+            return empty_;
+        }
+        return weekdays_[TimeUtils::weekdayFromDays(day)];
+    }
+
+    // **Looks the month and day up in the recurring holidays**
+    bool MinuteMaskCalendar::isRecurringHoliday(int day) const {
+        if (recurring_holidays_.empty()) {
+            return false;
+        }
+        const auto [year, month, month_day] = TimeUtils::civilFromDays(day);
+        return recurring_holidays_.count(std::make_pair(month, month_day)) > 0;
+    }
+
+    // **Earliest own mask or recurring holiday at or after the day**
+    std::optional<int> MinuteMaskCalendar::nextSpecialDay(int day) const {
+        std::optional<int> special;
+        auto it = dates_.lower_bound(day);
+        if (it != dates_.end()) {
+            special = it->first;
+        }
+        const int year = std::get<0>(TimeUtils::civilFromDays(day));
+        for (const auto& [month, month_day] : recurring_holidays_) {
+            // Feb 29 can be up to eight years away
+            for (int candidate_year = year; candidate_year <= year + 8; ++candidate_year) {
+                if (month_day > TimeUtils::daysInMonth(candidate_year, month)) {
+                    continue;
+                }
+                int candidate = TimeUtils::daysFromCivil(candidate_year, month, month_day);
+                if (candidate >= day) {
+                    special = special ? std::min(*special, candidate) : candidate;
+                    break;
+                }
+            }
+        }
+        return special;
+    }
+
+    // **Latest own mask or recurring holiday at or before the day**
+    std::optional<int> MinuteMaskCalendar::previousSpecialDay(int day) const {
+        std::optional<int> special;
+        auto it = dates_.upper_bound(day);
+        if (it != dates_.begin()) {
+            special = std::prev(it)->first;
+        }
+        const int year = std::get<0>(TimeUtils::civilFromDays(day));
+        for (const auto& [month, month_day] : recurring_holidays_) {
+            for (int candidate_year = year; candidate_year >= year - 8; --candidate_year) {
+                if (month_day > TimeUtils::daysInMonth(candidate_year, month)) {
+                    continue;
+                }
+                int candidate = TimeUtils::daysFromCivil(candidate_year, month, month_day);
+                if (candidate <= day) {
+                    special = special ? std::max(*special, candidate) : candidate;
+                    break;
+                }
+            }
+        }
+        return special;
+    }
+
+    // **Sums the daily totals, a whole week at a time between special days**
+    long long MinuteMaskCalendar::countWorkingMinutes(int from, int to, int /*workdayMinutes*/) const {
+        long long minutes = 0;
+        int day = from;
+        while (day < to) {
+            std::optional<int> special = nextSpecialDay(day);
+            int plain_end = special ? std::min(*special, to) : to;
+            const int weeks = (plain_end - day) / DAYS_IN_WEEK;
+            minutes += static_cast<long long>(weeks) * weekly_minutes_;
+            day += weeks * DAYS_IN_WEEK;
+            for (; day < plain_end; ++day) {
+                minutes += weekdays_[TimeUtils::weekdayFromDays(day)].total();
+            }
+            if (day < to) {
+                minutes += maskOf(day).total();
+                ++day;
+            }
+        }
+        return minutes;
+    }
+
+    // **Rank and select inside a day, daily totals and week jumps across days**
+    bool MinuteMaskCalendar::advanceWorkingMinutes(int& day, int& minuteOfDay, long long workingMinutes) const {
+        const bool decrement = workingMinutes < 0;
+        long long remaining = decrement ? -workingMinutes : workingMinutes;
+        if (remaining == 0) {
+            return true;
+        }
+
+        while (true) {
+            const DayMask& mask = maskOf(day);
+            const int worked = mask.rank(minuteOfDay);
+            if (decrement) {
+                if (remaining <= worked) {
+                    minuteOfDay = mask.select(worked - static_cast<int>(remaining));
+                    return true;
+                }
+                remaining -= worked;
+                --day;
+                minuteOfDay = MINUTES_IN_DAY;
+            }
+            else {
+                if (remaining <= mask.total() - worked) {
+                    minuteOfDay = mask.select(worked + static_cast<int>(remaining) - 1) + 1;
+                    if (minuteOfDay == MINUTES_IN_DAY) {
+                        // Worked up to midnight, report it as 00:00 of the next day
+                        ++day;
+                        minuteOfDay = 0;
+                    }
+                    return true;
+                }
+                remaining -= mask.total() - worked;
+                ++day;
+                minuteOfDay = 0;
+            }
+
+            if (weekly_minutes_ == 0) {
+                // Only dates with their own mask can have minutes, jump to the next one
+                auto it = decrement ? dates_.upper_bound(day) : dates_.lower_bound(day);
+                if (decrement ? it == dates_.begin() : it == dates_.end()) {
+                    Logger::getInstance().logInfo("No working minutes left", LOG_LOCATION);
+                    return false;
+                }
+                day = decrement ? std::prev(it)->first : it->first;
+                continue;
+            }
+
+            // Whole weeks of template days, keeping at least one day's worth for the loop above
+            std::optional<int> special = decrement ? previousSpecialDay(day) : nextSpecialDay(day);
+            long long plain_days = special ? (decrement ? day - *special : *special - day)
+                : std::numeric_limits<long long>::max();
+            long long weeks = std::min(plain_days / DAYS_IN_WEEK, (remaining - 1) / weekly_minutes_);
+            remaining -= weeks * weekly_minutes_;
+            day += static_cast<int>(decrement ? -weeks * DAYS_IN_WEEK : weeks * DAYS_IN_WEEK);
+        }
+    }
+
+} // namespace Workday
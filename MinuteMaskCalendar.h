@@ -0,0 +1,215 @@
+/**
+ * @file MinuteMaskCalendar.h
+ * @brief Header file for the Workday::MinuteMaskCalendar class, a calendar with minute resolution.
+ *
+ * Every day's availability is a 1440-bit mask (one bit per minute, set when the minute is worked)
+ * with popcount prefix counts per 64-bit word. A weekly template gives the mask of each weekday;
+ * single dates can replace it. Counting the working minutes before a time is a rank over the mask
+ * and "the n-th working minute of the day" is a select, so irregular availability (split shifts,
+ * on-call slots, maintenance windows) needs no per-minute loops. Runs of template days are skipped
+ * a week at a time using the weekly total.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef MINUTE_MASK_CALENDAR_H
+#define MINUTE_MASK_CALENDAR_H
+
+#include "BitmapUtils.h"
+#include "Calendar.h"
+#include "TimeUtils.h"
+#include <array>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace Workday {
+
+    // Words in the mask of one day
+    const int MINUTE_MASK_WORDS = BitmapUtils::wordCount(MINUTES_IN_DAY);
+
+    /**
+     * @class MinuteMaskCalendar
+     * @brief Calendar storing the available minutes of each day as a bit mask.
+     *
+     * Use it through BasicWorkdayCalendar (or WorkdayCalendar) with the working minute queries; the
+     * calendar's masks replace the work hours, which do not need to be set.
+     */
+    class MinuteMaskCalendar final : public Calendar {
+    public:
+        /**
+         * @brief Default constructor, creates a calendar without any working minutes.
+         */
+        MinuteMaskCalendar();
+
+        /**
+         * @brief Marks a range of minutes as available or not on every such weekday.
+         * @param weekday The weekday, SUNDAY (0) to SATURDAY (6).
+         * @param startMinutes Start of the range in minutes since midnight.
+         * @param stopMinutes Stop of the range in minutes since midnight.
+         * @param available True to make the minutes working minutes.
+         */
+        void setWeekdayMinutes(int weekday, int startMinutes, int stopMinutes, bool available);
+
+        /**
+         * @brief Marks a range of minutes as available or not on a single date. The first change of a
+         * date starts from the mask the date had so far.
+         * @param date The date, its time is ignored.
+         * @param startMinutes Start of the range in minutes since midnight.
+         * @param stopMinutes Stop of the range in minutes since midnight.
+         * @param available True to make the minutes working minutes.
+         */
+        void setDateMinutes(const Date& date, int startMinutes, int stopMinutes, bool available);
+
+        /**
+         * @brief Removes every working minute of a date.
+         * @param date The date.
+         */
+        void setHoliday(const Date& date) override;
+
+        /**
+         * @brief Removes every working minute of a month and day in every year, unless the date has
+         * its own mask.
+         * @param date The date giving month and day.
+         */
+        void setRecurringHoliday(const Date& date) override;
+
+        /**
+         * @brief Adds a day to the specified date.
+         * @param date_i The date to add a day to.
+         */
+        void addDay(Date& date_i) const override;
+
+        /**
+         * @brief Removes a day from the specified date.
+         * @param date_i The date to remove a day from.
+         */
+        void removeDay(Date& date_i) const override;
+
+        /**
+         * @brief Checks if the specified date has no working minutes.
+         * @param date The date to check.
+         * @return True if the date is a holiday.
+         */
+        bool isHoliday(const Date& date) const override;
+
+        /**
+         * @brief Checks if the specified date is valid.
+         * @param date The date to check.
+         * @return True if the date is valid.
+         */
+        bool isValidDate(const Date& date) const override;
+
+        /**
+         * @brief Checks if the day with the given serial has no working minutes.
+         * @param day The day serial.
+         * @return True if the day is a holiday.
+         */
+        bool isHolidayDay(int day) const override {
+            return maskOf(day).total() == 0;
+        }
+
+        /**
+         * @brief Returns the working minutes of a day.
+         * @param day The day serial.
+         */
+        int getWorkingMinutes(int day) const {
+            return maskOf(day).total();
+        }
+
+        /**
+         * @brief Counts the working minutes in [from, to) from the masks.
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @param workdayMinutes Ignored, the masks give each day's minutes.
+         * @return The number of working minutes.
+         */
+        long long countWorkingMinutes(int from, int to, int workdayMinutes) const override;
+
+        /**
+         * @brief The calendar works in minutes.
+         */
+        bool hasMinuteMasks() const override {
+            return true;
+        }
+
+        /**
+         * @brief Moves a time by a number of working minutes. Moving forward ends at the end of the last
+         * minute worked, moving backward at the start of the last minute removed.
+         * @param day The day serial, updated to the resulting day.
+         * @param minuteOfDay The time in minutes since midnight, updated to the resulting time.
+         * @param workingMinutes The number of working minutes, negative to move backwards.
+         * @return False if the calendar runs out of working minutes.
+         */
+        bool advanceWorkingMinutes(int& day, int& minuteOfDay, long long workingMinutes) const override;
+
+    private:
+        /**
+         * @brief Availability of one day, with the prefix counts of its words.
+         */
+        struct DayMask {
+            std::array<std::uint64_t, MINUTE_MASK_WORDS> words{}; ///< Bit i set when minute i is worked
+            std::array<int, MINUTE_MASK_WORDS + 1> prefix{}; ///< Worked minutes before each word
+
+            /**
+             * @brief Sets or clears the minutes [startMinutes, stopMinutes) and updates the prefix counts.
+             */
+            void setRange(int startMinutes, int stopMinutes, bool available);
+
+            /**
+             * @brief Returns the worked minutes of the day.
+             */
+            int total() const {
+                return prefix[MINUTE_MASK_WORDS];
+            }
+
+            /**
+             * @brief Returns the worked minutes before a time of day.
+             */
+            int rank(int minuteOfDay) const {
+                return BitmapUtils::rank(words, prefix, minuteOfDay);
+            }
+
+            /**
+             * @brief Returns the minute of day of the k-th worked minute (0-based).
+             */
+            int select(int k) const {
+                return BitmapUtils::select(words, prefix, k);
+            }
+        };
+
+        /**
+         * @brief Returns the mask of a day: its own, an empty one for recurring holidays, or the weekday's.
+         */
+        const DayMask& maskOf(int day) const;
+
+        /**
+         * @brief Returns true if the day falls on a recurring holiday.
+         */
+        bool isRecurringHoliday(int day) const;
+
+        /**
+         * @brief Returns the first day at or after the given one that does not use the weekday template,
+         * or nothing if there is none.
+         */
+        std::optional<int> nextSpecialDay(int day) const;
+
+        /**
+         * @brief Returns the last day at or before the given one that does not use the weekday template,
+         * or nothing if there is none.
+         */
+        std::optional<int> previousSpecialDay(int day) const;
+
+        std::array<DayMask, DAYS_IN_WEEK> weekdays_; ///< Template mask of each weekday
+        std::map<int, DayMask> dates_; ///< Own masks by day serial
+        std::set<std::pair<int, int>> recurring_holidays_; ///< Month and day of recurring holidays
+        DayMask empty_; ///< Mask without working minutes
+        int weekly_minutes_; ///< Working minutes of the weekday templates
+    };
+
+} // namespace Workday
+
+#endif // MINUTE_MASK_CALENDAR_H
@@ -0,0 +1,116 @@
+/**
+ * @file PaymentSchedule.cpp
+ * @brief Implementation file for the PaymentSchedule class, generating business-day adjusted
+ * payment dates.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "PaymentSchedule.h"
+#include "TimeUtils.h"
+#include "logger.h"
+#include <algorithm>
+
+namespace Workday {
+
+    // **Adds whole months to the anchor and clamps the day to the month**
+    int PaymentSchedule::gridDay(const Grid& grid, int periods) {
+        const int months = grid.year * 12 + (grid.month - 1) + periods * grid.step;
+        const int year = months >= 0 ? months / 12 : (months - 11) / 12;
+        const int month = months - year * 12 + 1;
+        return TimeUtils::daysFromCivil(year, month, std::min(grid.day, TimeUtils::daysInMonth(year, month)));
+    }
+
+    // **Estimates the periods from the months between the ends, then settles the estimate on the grid**
+    PaymentSchedule::Grid PaymentSchedule::layGrid(int start, int end, Frequency frequency, StubRule stub) {
+        const bool from_end = stub == StubRule::ShortFront || stub == StubRule::LongFront;
+        const int period = static_cast<int>(frequency);
+        const auto [start_year, start_month, start_day] = TimeUtils::civilFromDays(start);
+        const auto [end_year, end_month, end_day] = TimeUtils::civilFromDays(end);
+
+        Grid grid{};
+        if (from_end) {
+            grid = Grid{ end_year, end_month, end_day, -period, 0, false };
+        }
+        else {
+            grid = Grid{ start_year, start_month, start_day, period, 0, false };
+        }
+        // Grid dates strictly inside the schedule lie before the end, or after the start from the end
+        auto inside = [&](int periods) {
+            const int day = gridDay(grid, periods);
+            return from_end ? day > start : day < end;
+        };
+        const int months = (end_year - start_year) * 12 + (end_month - start_month);
+        grid.last = months / period;
+        while (grid.last > 0 && !inside(grid.last)) {
+            --grid.last;
+        }
+        while (inside(grid.last + 1)) {
+            ++grid.last;
+        }
+
+        const bool has_stub = gridDay(grid, grid.last + 1) != (from_end ? start : end);
+        grid.merged = has_stub && grid.last > 0 && (stub == StubRule::LongFront || stub == StubRule::LongBack);
+        return grid;
+    }
+
+    // **Counts the grid dates inside the schedule, the two ends, less a merged stub date**
+    std::size_t PaymentSchedule::countDates(std::chrono::sys_days start, std::chrono::sys_days end,
+        Frequency frequency, StubRule stub) {
+        const int start_day = static_cast<int>(start.time_since_epoch().count());
+        const int end_day = static_cast<int>(end.time_since_epoch().count());
+        if (end_day <= start_day) {
+            return 0;
+        }
+        const Grid grid = layGrid(start_day, end_day, frequency, stub);
+        return static_cast<std::size_t>(grid.last + 2 - (grid.merged ? 1 : 0));
+    }
+
+    // **Writes the unadjusted dates in ascending order, then rolls the whole buffer in one batch**
+    std::size_t PaymentSchedule::generate(WorkdayCalendar& calendar, std::chrono::sys_days start, std::chrono::sys_days end,
+        Frequency frequency, StubRule stub, RollConvention convention, std::span<std::chrono::sys_days> dates) {
+        const int start_day = static_cast<int>(start.time_since_epoch().count());
+        const int end_day = static_cast<int>(end.time_since_epoch().count());
+        if (end_day <= start_day) {
+            Logger::getInstance().logInfo("Invalid schedule range", LOG_LOCATION);
+            return 0;
+        }
+        const Grid grid = layGrid(start_day, end_day, frequency, stub);
+        const std::size_t count = static_cast<std::size_t>(grid.last + 2 - (grid.merged ? 1 : 0));
+        if (dates.size() < count) {
+            Logger::getInstance().logInfo("Schedule buffer too small", LOG_LOCATION);
+            return 0;
+        }
+
+        auto toSysDays = [](int day) {
+            return std::chrono::sys_days(std::chrono::days(day));
+        };
+        // A merged stub drops the grid date next to the stub, the one furthest from the anchor
+        const int last = grid.merged ? grid.last - 1 : grid.last;
+        std::size_t written = 0;
+        if (grid.step < 0) {
+            dates[written++] = start;
+            for (int periods = last; periods >= 1; --periods) {
+                dates[written++] = toSysDays(gridDay(grid, periods));
+            }
+            dates[written++] = end;
+        }
+        else {
+            dates[written++] = start;
+            for (int periods = 1; periods <= last; ++periods) {
+                dates[written++] = toSysDays(gridDay(grid, periods));
+            }
+            dates[written++] = end;
+        }
+
+        const std::span<std::chrono::sys_days> schedule = dates.first(written);
+        if (!calendar.getRolledDays(schedule, convention, schedule)) {
+            return 0;
+        }
+        return written;
+    }
+
+} // namespace Workday
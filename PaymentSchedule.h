@@ -0,0 +1,119 @@
+/**
+ * @file PaymentSchedule.h
+ * @brief Header file for the Workday::PaymentSchedule class, generating business-day adjusted
+ * payment dates.
+ *
+ * A schedule runs from a start to an end date in regular periods of whole months. The dates are
+ * laid on a grid anchored on the start (back stubs) or on the end (front stubs): every grid date is
+ * computed from the anchor directly, clamped to the length of its month, so a 31st anchor gives
+ * month ends without drifting. Where the period does not divide the range a stub is left, short or
+ * merged into its neighbouring period when long. The dates are then rolled to workdays in one
+ * batch call on the calendar, so each date costs one next/previous workday lookup.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef PAYMENT_SCHEDULE_H
+#define PAYMENT_SCHEDULE_H
+
+#include "RollConvention.h"
+#include "WorkdayCalendar.h"
+#include <chrono>
+#include <cstddef>
+#include <span>
+
+namespace Workday {
+
+    /**
+     * @enum Frequency
+     * @brief Length of the regular schedule periods, the value is the number of months.
+     */
+    enum class Frequency {
+        Monthly = 1,
+        Quarterly = 3,
+        SemiAnnual = 6,
+        Annual = 12
+    };
+
+    /**
+     * @enum StubRule
+     * @brief Where the irregular period goes when the frequency does not divide the schedule.
+     */
+    enum class StubRule {
+        ShortFront, ///< Grid anchored on the end, a short first period
+        LongFront,  ///< Grid anchored on the end, the short first period merged into the second
+        ShortBack,  ///< Grid anchored on the start, a short last period
+        LongBack    ///< Grid anchored on the start, the short last period merged into the one before
+    };
+
+    /**
+     * @class PaymentSchedule
+     * @brief Generates the dates of a schedule, start and end included, into a caller supplied buffer.
+     */
+    class PaymentSchedule {
+    public:
+        /**
+         * @brief Returns the number of dates of a schedule, to size the buffer for generate().
+         * @param start The start date of the schedule.
+         * @param end The end date of the schedule, after the start.
+         * @param frequency The length of the regular periods.
+         * @param stub The stub rule.
+         * @return The number of dates, start and end included, or 0 if the range is empty.
+         */
+        static std::size_t countDates(std::chrono::sys_days start, std::chrono::sys_days end,
+            Frequency frequency, StubRule stub);
+
+        /**
+         * @brief Generates the dates of a schedule, each rolled to a workday of the calendar.
+         * @param calendar The calendar the dates are rolled on.
+         * @param start The start date of the schedule.
+         * @param end The end date of the schedule, after the start.
+         * @param frequency The length of the regular periods.
+         * @param stub The stub rule.
+         * @param convention The roll convention applied to every date, start and end included.
+         * @param dates Output, must hold countDates() entries; receives the dates in ascending order.
+         * @return The number of dates written, 0 if the range is empty, the buffer too small or the
+         * calendar not usable.
+         */
+        static std::size_t generate(WorkdayCalendar& calendar, std::chrono::sys_days start, std::chrono::sys_days end,
+            Frequency frequency, StubRule stub, RollConvention convention, std::span<std::chrono::sys_days> dates);
+
+    private:
+        /**
+         * @struct Grid
+         * @brief The regular dates of a schedule: offsets 0 to last periods from the anchor.
+         */
+        struct Grid {
+            int year;      ///< Year of the anchor
+            int month;     ///< Month of the anchor
+            int day;       ///< Day of the month of the anchor
+            int step;      ///< Months per period, negative for a grid anchored on the end
+            int last;      ///< Number of periods on the grid strictly inside the schedule
+            bool merged;   ///< True if the last grid date is dropped to make a long stub
+        };
+
+        /**
+         * @brief Lays the grid of a schedule.
+         * @param start The start day serial.
+         * @param end The end day serial, after the start.
+         * @param frequency The length of the regular periods.
+         * @param stub The stub rule.
+         * @return The grid.
+         */
+        static Grid layGrid(int start, int end, Frequency frequency, StubRule stub);
+
+        /**
+         * @brief Returns the day serial of a grid date.
+         * @param grid The grid.
+         * @param periods The number of periods from the anchor.
+         * @return The day serial, the anchor day clamped to the length of the month.
+         */
+        static int gridDay(const Grid& grid, int periods);
+    };
+
+} // namespace Workday
+
+#endif // PAYMENT_SCHEDULE_H
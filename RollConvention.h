@@ -0,0 +1,33 @@
+/**
+ * @file RollConvention.h
+ * @brief Header file for the Workday::RollConvention enumeration, business-day adjustment of dates.
+ *
+ * A date that falls on a weekend or holiday is rolled to a workday. Following and Preceding take the
+ * next or the previous workday; the modified conventions do the same unless that leaves the month,
+ * in which case they roll the other way.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef ROLL_CONVENTION_H
+#define ROLL_CONVENTION_H
+
+namespace Workday {
+
+    /**
+     * @enum RollConvention
+     * @brief How a date that is not a workday is moved to one.
+     */
+    enum class RollConvention {
+        Following,          ///< The next workday
+        ModifiedFollowing,  ///< The next workday, or the previous one if the next is in another month
+        Preceding,          ///< The previous workday
+        ModifiedPreceding   ///< The previous workday, or the next one if the previous is in another month
+    };
+
+} // namespace Workday
+
+#endif // ROLL_CONVENTION_H
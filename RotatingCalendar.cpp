@@ -0,0 +1,226 @@
+/**
+ * @file RotatingCalendar.cpp
+ * @brief Implementation file for the RotatingCalendar class, a calendar of repeating shift rotations.
+ *
+ * This file contains the period arithmetic on the pattern (rank and select through the period
+ * tables) and the correction for the holidays layered on top of it.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "RotatingCalendar.h"
+#include "logger.h"
+#include <bit>
+
+namespace Workday {
+
+    namespace {
+        // Division rounding toward negative infinity, for days and ranks before the anchor
+        long long floorDiv(long long value, long long divisor) {
+            long long quotient = value / divisor;
+            if (value % divisor != 0 && (value < 0) != (divisor < 0)) {
+                --quotient;
+            }
+            return quotient;
+        }
+    }
+
+    // **Constructor - builds the period tables from the pattern**
+    RotatingCalendar::RotatingCalendar(const Date& anchor, std::uint64_t pattern, int periodDays)
+        : Calendar(), anchor_day_(0), period_days_(1), pattern_(0), workdays_per_period_(0),
+        holidays_(), recurring_holidays_() {
+        if (periodDays < 1 || periodDays > BITS_IN_WORD || !TimeUtils::isValidDate(anchor)) {
+            Logger::getInstance().logInfo("Invalid rotation", LOG_LOCATION);
+            return;
+        }
+        if (periodDays < BITS_IN_WORD) {
+            pattern &= (std::uint64_t{ 1 } << periodDays) - 1;
+        }
+        if (pattern == 0) {
+            Logger::getInstance().logInfo("Rotation has no workdays", LOG_LOCATION);
+            return;
+        }
+
+        anchor_day_ = TimeUtils::toDaySerial(anchor);
+        period_days_ = periodDays;
+        pattern_ = pattern;
+        workdays_per_period_ = std::popcount(pattern);
+        for (int position = 0; position < period_days_; ++position) {
+            const bool workday = (pattern_ >> position) & 1u;
+            if (workday) {
+                workday_positions_[workdays_before_[position]] = position;
+            }
+            workdays_before_[position + 1] = workdays_before_[position] + (workday ? 1 : 0);
+        }
+    }
+
+    // **Stores the day serial of the holiday**
+    void RotatingCalendar::setHoliday(const Date& date) {
+        if (isValidDate(date)) {
+            holidays_.insert(TimeUtils::toDaySerial(date));
+        }
+    }
+
+    // **Stores month and day as a pair**
+    void RotatingCalendar::setRecurringHoliday(const Date& date) {
+        if (isValidDate(date)) {
+            recurring_holidays_.insert(std::make_pair(date.getMonth(), date.getDay()));
+        }
+    }
+
+    // **Moves to the next day serial**
+    void RotatingCalendar::addDay(Date& date_i) const {
+        TimeUtils::setDaySerial(date_i, TimeUtils::toDaySerial(date_i) + 1);
+    }
+
+    // **Moves to the previous day serial**
+    void RotatingCalendar::removeDay(Date& date_i) const {
+        TimeUtils::setDaySerial(date_i, TimeUtils::toDaySerial(date_i) - 1);
+    }
+
+    // **Off days of the rotation and holidays are not worked**
+    bool RotatingCalendar::isHoliday(const Date& date) const {
+        return isHolidayDay(TimeUtils::toDaySerial(date));
+    }
+
+    // **Validates year, month, day, hour, and minute ranges**
+    bool RotatingCalendar::isValidDate(const Date& date) const {
+        return TimeUtils::isValidDate(date);
+    }
+
+    // **Moves the date to the next workday serial, keeping its time**
+    void RotatingCalendar::nextWorkday(Date& date) const {
+        TimeUtils::setDaySerial(date, nextWorkdayDay(TimeUtils::toDaySerial(date)));
+    }
+
+    // **Moves the date to the previous workday serial, keeping its time**
+    void RotatingCalendar::previousWorkday(Date& date) const {
+        TimeUtils::setDaySerial(date, previousWorkdayDay(TimeUtils::toDaySerial(date)));
+    }
+
+    // **Moves the date by workdays on the day serial, keeping its time**
+    void RotatingCalendar::advanceWorkdays(Date& date, int workdays) const {
+        TimeUtils::setDaySerial(date, advanceWorkdaysDay(TimeUtils::toDaySerial(date), workdays));
+    }
+
+    // **Counts the workdays between the day serials of the dates**
+    int RotatingCalendar::countWorkdays(const Date& from, const Date& to) const {
+        return countWorkdaysDay(TimeUtils::toDaySerial(from), TimeUtils::toDaySerial(to));
+    }
+
+    // **Offset from the anchor modulo the period**
+    int RotatingCalendar::positionOf(int day) const {
+        const int position = (day - anchor_day_) % period_days_;
+        return position < 0 ? position + period_days_ : position;
+    }
+
+    // **Looks the day up in the one-time and the recurring holidays**
+    bool RotatingCalendar::isSetHoliday(int day) const {
+        if (holidays_.count(day) > 0) {
+            return true;
+        }
+        if (recurring_holidays_.empty()) {
+            return false;
+        }
+        const auto [year, month, month_day] = TimeUtils::civilFromDays(day);
+        return recurring_holidays_.count(std::make_pair(month, month_day)) > 0;
+    }
+
+    // **Whole periods times the workdays per period, plus the workdays before the position**
+    long long RotatingCalendar::patternRank(int day) const {
+        const long long offset = static_cast<long long>(day) - anchor_day_;
+        const long long periods = floorDiv(offset, period_days_);
+        return periods * workdays_per_period_ + workdays_before_[offset - periods * period_days_];
+    }
+
+    // **Whole periods from the division by the workdays per period, the rest from the position table**
+    int RotatingCalendar::patternSelect(long long rank) const {
+        const long long periods = floorDiv(rank, workdays_per_period_);
+        return static_cast<int>(anchor_day_ + periods * period_days_ +
+            workday_positions_[rank - periods * workdays_per_period_]);
+    }
+
+    // **Selects the pattern workday whose rank is offset by the given count**
+    int RotatingCalendar::advancePatternDay(int day, int workdays) const {
+        if (workdays == 0) {
+            return day;
+        }
+        // Forward: the n-th workday after day has rank (workdays up to and including day) + n - 1
+        // Backward: the n-th workday before day has rank (workdays before day) - n
+        return workdays > 0
+            ? patternSelect(patternRank(day + 1) + workdays - 1)
+            : patternSelect(patternRank(day) + workdays);
+    }
+
+    // **Moves on the pattern, then again by the holidays passed until none are left in the last step**
+    int RotatingCalendar::advanceWorkdaysDay(int day, int workdays) const {
+        if (workdays_per_period_ == 0 || workdays == 0) {
+            return day;
+        }
+        int target = advancePatternDay(day, workdays);
+        if (workdays > 0) {
+            int skipped = countHolidayWorkdays(day + 1, target + 1);
+            while (skipped > 0) {
+                const int next = advancePatternDay(target, skipped);
+                skipped = countHolidayWorkdays(target + 1, next + 1);
+                target = next;
+            }
+        }
+        else {
+            int skipped = countHolidayWorkdays(target, day);
+            while (skipped > 0) {
+                const int next = advancePatternDay(target, -skipped);
+                skipped = countHolidayWorkdays(next, target);
+                target = next;
+            }
+        }
+        return target;
+    }
+
+    // **Pattern workdays as the difference of two ranks, less the holidays among them**
+    int RotatingCalendar::countWorkdaysDay(int from, int to) const {
+        if (to <= from || workdays_per_period_ == 0) {
+            return 0;
+        }
+        return static_cast<int>(patternRank(to) - patternRank(from)) - countHolidayWorkdays(from, to);
+    }
+
+    // **One-time holidays from the sorted set, recurring ones once per year of the range**
+    int RotatingCalendar::countHolidayWorkdays(int from, int to) const {
+        if (to <= from) {
+            return 0;
+        }
+        int count = 0;
+        const bool recurring = !recurring_holidays_.empty();
+        for (auto it = holidays_.lower_bound(from); it != holidays_.end() && *it < to; ++it) {
+            if (!isPatternWorkday(*it)) {
+                continue;
+            }
+            // Holidays on a recurring date are counted with the recurring ones
+            const auto [year, month, month_day] = TimeUtils::civilFromDays(*it);
+            if (!recurring || recurring_holidays_.count(std::make_pair(month, month_day)) == 0) {
+                ++count;
+            }
+        }
+        if (recurring) {
+            const int first_year = std::get<0>(TimeUtils::civilFromDays(from));
+            const int last_year = std::get<0>(TimeUtils::civilFromDays(to - 1));
+            for (const auto& [month, month_day] : recurring_holidays_) {
+                for (int year = first_year; year <= last_year; ++year) {
+                    if (month_day > TimeUtils::daysInMonth(year, month)) {
+                        continue;
+                    }
+                    const int day = TimeUtils::daysFromCivil(year, month, month_day);
+                    if (day >= from && day < to && isPatternWorkday(day)) {
+                        ++count;
+                    }
+                }
+            }
+        }
+        return count;
+    }
+
+} // namespace Workday
@@ -0,0 +1,223 @@
+/**
+ * @file RotatingCalendar.h
+ * @brief Header file for the Workday::RotatingCalendar class, a calendar of repeating shift rotations.
+ *
+ * Plant rotations such as 4-on/4-off or 2-2-3 ignore the Monday to Friday week: a team works the
+ * days set in a pattern of up to 64 days that repeats from an anchor date. Workday arithmetic on the
+ * pattern alone is constant time: whole periods are a division by the workdays per period, and the
+ * remainder is looked up in two small tables (workdays before each position of the period and the
+ * position of each workday). One-time and recurring holidays are layered on top and only cost a
+ * lookup per holiday that falls in the range.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef ROTATING_CALENDAR_H
+#define ROTATING_CALENDAR_H
+
+#include "BitmapUtils.h"
+#include "Calendar.h"
+#include "TimeUtils.h"
+#include <array>
+#include <cstdint>
+#include <set>
+
+namespace Workday {
+
+    /**
+     * @class RotatingCalendar
+     * @brief Calendar whose workdays repeat in a fixed-length pattern from an anchor date.
+     */
+    class RotatingCalendar final : public Calendar {
+    public:
+        /**
+         * @brief Constructor.
+         * An invalid pattern (period outside 1..64 or no workday in the period) is logged and leaves
+         * the calendar without workdays; the workday queries then return the day they were given.
+         * @param anchor The date the pattern starts on, its time is ignored.
+         * @param pattern Bit i is set if day i of the period is a workday.
+         * @param periodDays The length of the period in days, 1 to 64.
+         */
+        RotatingCalendar(const Date& anchor, std::uint64_t pattern, int periodDays);
+
+        /**
+         * @brief Builds the pattern of a simple rotation: onDays workdays followed by offDays days off.
+         * @param onDays The workdays at the start of the period.
+         * @param offDays The days off after them.
+         * @return The pattern, to be used with a period of onDays + offDays.
+         */
+        static constexpr std::uint64_t onOffPattern(int onDays, int offDays) {
+            return onDays <= 0 || onDays + offDays > BITS_IN_WORD ? 0
+                : (onDays == BITS_IN_WORD ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << onDays) - 1);
+        }
+
+        /**
+         * @brief Sets a specific date as a holiday.
+         * @param date The date to be set as a holiday.
+         */
+        void setHoliday(const Date& date) override;
+
+        /**
+         * @brief Sets a recurring holiday on the same month and day every year.
+         * @param date The date giving month and day.
+         */
+        void setRecurringHoliday(const Date& date) override;
+
+        /**
+         * @brief Adds a day to the specified date.
+         * @param date_i The date to add a day to.
+         */
+        void addDay(Date& date_i) const override;
+
+        /**
+         * @brief Removes a day from the specified date.
+         * @param date_i The date to remove a day from.
+         */
+        void removeDay(Date& date_i) const override;
+
+        /**
+         * @brief Checks if the specified date is an off day of the rotation or a holiday.
+         * @param date The date to check.
+         * @return True if the date is not worked.
+         */
+        bool isHoliday(const Date& date) const override;
+
+        /**
+         * @brief Checks if the specified date is valid.
+         * @param date The date to check.
+         * @return True if the date is valid.
+         */
+        bool isValidDate(const Date& date) const override;
+
+        /**
+         * @brief Moves the given date to the first workday after it.
+         * @param date The date to move; its time is kept.
+         */
+        void nextWorkday(Date& date) const override;
+
+        /**
+         * @brief Moves the given date to the last workday before it.
+         * @param date The date to move; its time is kept.
+         */
+        void previousWorkday(Date& date) const override;
+
+        /**
+         * @brief Moves the given date by a number of workdays.
+         * @param date The date to move; its time is kept.
+         * @param workdays The number of workdays to move, negative to move backwards.
+         */
+        void advanceWorkdays(Date& date, int workdays) const override;
+
+        /**
+         * @brief Counts the workdays in [from, to), ignoring the time of day.
+         * @param from The first day of the range.
+         * @param to The day after the last day of the range.
+         * @return The number of workdays, zero if to is not after from.
+         */
+        int countWorkdays(const Date& from, const Date& to) const override;
+
+        /**
+         * @brief Checks if the day with the given serial is an off day of the rotation or a holiday.
+         * @param day The day serial.
+         * @return True if the day is not worked.
+         */
+        bool isHolidayDay(int day) const override {
+            return !isPatternWorkday(day) || isSetHoliday(day);
+        }
+
+        /**
+         * @brief Returns the first workday after the given day serial.
+         * @param day The day serial.
+         * @return The day serial of the workday.
+         */
+        int nextWorkdayDay(int day) const override {
+            return advanceWorkdaysDay(day, 1);
+        }
+
+        /**
+         * @brief Returns the last workday before the given day serial.
+         * @param day The day serial.
+         * @return The day serial of the workday.
+         */
+        int previousWorkdayDay(int day) const override {
+            return advanceWorkdaysDay(day, -1);
+        }
+
+        /**
+         * @brief Moves a day serial by a number of workdays, on the pattern first and then past the
+         * holidays that fell in between.
+         * @param day The day serial.
+         * @param workdays The number of workdays to move, negative to move backwards.
+         * @return The day serial reached.
+         */
+        int advanceWorkdaysDay(int day, int workdays) const override;
+
+        /**
+         * @brief Counts the workdays in the day serials [from, to).
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @return The number of workdays, zero if to is not after from.
+         */
+        int countWorkdaysDay(int from, int to) const override;
+
+        /**
+         * @brief Returns the workdays in one period of the pattern.
+         */
+        int getWorkdaysPerPeriod() const {
+            return workdays_per_period_;
+        }
+
+    private:
+        /**
+         * @brief Returns the position of a day in the period, 0 for the anchor.
+         */
+        int positionOf(int day) const;
+
+        /**
+         * @brief Returns true if the pattern has the day as a workday, holidays not considered.
+         */
+        bool isPatternWorkday(int day) const {
+            return workdays_per_period_ > 0 && ((pattern_ >> positionOf(day)) & 1u);
+        }
+
+        /**
+         * @brief Returns true if the day is a one-time or recurring holiday.
+         */
+        bool isSetHoliday(int day) const;
+
+        /**
+         * @brief Counts the pattern workdays in [anchor, day), negative for a day before the anchor.
+         */
+        long long patternRank(int day) const;
+
+        /**
+         * @brief Returns the pattern workday with the given rank counted from the anchor.
+         */
+        int patternSelect(long long rank) const;
+
+        /**
+         * @brief Moves a day serial by a number of pattern workdays, holidays not considered.
+         */
+        int advancePatternDay(int day, int workdays) const;
+
+        /**
+         * @brief Counts the pattern workdays in [from, to) that are holidays.
+         */
+        int countHolidayWorkdays(int from, int to) const;
+
+        int anchor_day_; ///< Day serial of position 0
+        int period_days_; ///< Length of the period
+        std::uint64_t pattern_; ///< Bit i set if position i is a workday
+        int workdays_per_period_; ///< Workdays in one period
+        std::array<int, BITS_IN_WORD + 1> workdays_before_{}; ///< Workdays before each position
+        std::array<int, BITS_IN_WORD> workday_positions_{}; ///< Position of each workday of the period
+        std::set<int> holidays_; ///< One-time holidays by day serial
+        std::set<std::pair<int, int>> recurring_holidays_; ///< Month and day of recurring holidays
+    };
+
+} // namespace Workday
+
+#endif // ROTATING_CALENDAR_H
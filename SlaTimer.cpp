@@ -0,0 +1,123 @@
+/**
+ * @file SlaTimer.cpp
+ * @brief Implementation file for the SlaTimer class, a service level clock counting working minutes
+ * across pause and resume events.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "SlaTimer.h"
+#include "TimeUtils.h"
+#include "logger.h"
+
+namespace Workday {
+
+    namespace {
+        // Appends a 64-bit value, least significant byte first
+        void writeLittleEndian(std::string& out, std::int64_t value) {
+            const std::uint64_t bits = static_cast<std::uint64_t>(value);
+            for (int byte = 0; byte < 8; ++byte) {
+                out.push_back(static_cast<char>((bits >> (8 * byte)) & 0xFF));
+            }
+        }
+
+        // Reads a 64-bit value written by writeLittleEndian
+        std::int64_t readLittleEndian(const std::string& data, std::size_t offset) {
+            std::uint64_t bits = 0;
+            for (int byte = 0; byte < 8; ++byte) {
+                bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[offset + byte])) << (8 * byte);
+            }
+            return static_cast<std::int64_t>(bits);
+        }
+
+        const unsigned char FLAG_RUNNING = 1;
+    }
+
+    // **Constructor - paused with nothing consumed**
+    SlaTimer::SlaTimer(WorkdayCalendar* calendar, long long targetMinutes)
+        : calendar_(calendar), target_minutes_(targetMinutes < 0 ? 0 : targetMinutes), elapsed_minutes_(0),
+        running_(false), last_event_at_(INVALID_EPOCH_MINUTES), breach_at_(INVALID_EPOCH_MINUTES) {
+        if (calendar == nullptr || targetMinutes < 0) {
+            Logger::getInstance().logInfo("Invalid SLA timer", LOG_LOCATION);
+        }
+    }
+
+    // **Projects the breach from the remaining budget unless it has already happened**
+    bool SlaTimer::resume(std::int64_t epochMinutes) {
+        if (calendar_ == nullptr || running_ || !TimeUtils::isValidEpochMinutes(epochMinutes) ||
+            (last_event_at_ != INVALID_EPOCH_MINUTES && epochMinutes < last_event_at_)) {
+            Logger::getInstance().logInfo("Invalid resume", LOG_LOCATION);
+            return false;
+        }
+        running_ = true;
+        last_event_at_ = epochMinutes;
+        if (elapsed_minutes_ < target_minutes_) {
+            breach_at_ = calendar_->getEpochMinutesIncrement(epochMinutes, target_minutes_ - elapsed_minutes_);
+        }
+        return true;
+    }
+
+    // **Adds the working minutes of the segment, forgets a breach that has not happened yet**
+    bool SlaTimer::pause(std::int64_t epochMinutes) {
+        if (!running_ || !TimeUtils::isValidEpochMinutes(epochMinutes) || epochMinutes < last_event_at_) {
+            Logger::getInstance().logInfo("Invalid pause", LOG_LOCATION);
+            return false;
+        }
+        const long long segment = calendar_->getWorkingMinutesBetween(last_event_at_, epochMinutes);
+        if (segment < 0) {
+            return false;
+        }
+        running_ = false;
+        last_event_at_ = epochMinutes;
+        elapsed_minutes_ += segment;
+        if (elapsed_minutes_ < target_minutes_) {
+            breach_at_ = INVALID_EPOCH_MINUTES;
+        }
+        return true;
+    }
+
+    // **Finished segments plus the running one up to the time**
+    long long SlaTimer::getElapsedMinutes(std::int64_t epochMinutes) const {
+        if (!running_ || epochMinutes <= last_event_at_) {
+            return elapsed_minutes_;
+        }
+        const long long segment = calendar_->getWorkingMinutesBetween(last_event_at_, epochMinutes);
+        return elapsed_minutes_ + (segment > 0 ? segment : 0);
+    }
+
+    // **Flag byte, then target, elapsed, last event and breach times**
+    std::string SlaTimer::serialize() const {
+        std::string out;
+        out.reserve(SLA_TIMER_SERIALIZED_SIZE);
+        out.push_back(static_cast<char>(running_ ? FLAG_RUNNING : 0));
+        writeLittleEndian(out, target_minutes_);
+        writeLittleEndian(out, elapsed_minutes_);
+        writeLittleEndian(out, last_event_at_);
+        writeLittleEndian(out, breach_at_);
+        return out;
+    }
+
+    // **Checks the size and the fields before restoring them**
+    std::optional<SlaTimer> SlaTimer::deserialize(WorkdayCalendar* calendar, const std::string& data) {
+        if (calendar == nullptr || data.size() != SLA_TIMER_SERIALIZED_SIZE ||
+            (static_cast<unsigned char>(data[0]) & ~FLAG_RUNNING) != 0) {
+            Logger::getInstance().logInfo("Invalid serialized SLA timer", LOG_LOCATION);
+            return std::nullopt;
+        }
+        SlaTimer timer(calendar, readLittleEndian(data, 1));
+        timer.running_ = (static_cast<unsigned char>(data[0]) & FLAG_RUNNING) != 0;
+        timer.elapsed_minutes_ = readLittleEndian(data, 9);
+        timer.last_event_at_ = readLittleEndian(data, 17);
+        timer.breach_at_ = readLittleEndian(data, 25);
+        if (timer.target_minutes_ < 0 || timer.elapsed_minutes_ < 0 ||
+            (timer.running_ && !TimeUtils::isValidEpochMinutes(timer.last_event_at_))) {
+            Logger::getInstance().logInfo("Invalid serialized SLA timer", LOG_LOCATION);
+            return std::nullopt;
+        }
+        return timer;
+    }
+
+} // namespace Workday
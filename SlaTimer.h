@@ -0,0 +1,116 @@
+/**
+ * @file SlaTimer.h
+ * @brief Header file for the Workday::SlaTimer class, a service level clock counting working minutes
+ * across pause and resume events.
+ *
+ * The timer keeps the working minutes of its finished segments and the start of the running one.
+ * Pausing adds the working minutes of the segment once, with one getWorkingMinutesBetween call;
+ * resuming computes the projected breach time once, with one increment of the remaining budget.
+ * The queries then read the kept state, plus one working minute count for a running segment.
+ * The state serializes to 33 bytes.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef SLA_TIMER_H
+#define SLA_TIMER_H
+
+#include "WorkdayCalendar.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Workday {
+
+    const std::size_t SLA_TIMER_SERIALIZED_SIZE = 33; ///< Bytes of a serialized SlaTimer
+
+    /**
+     * @class SlaTimer
+     * @brief Working minute budget consumed while running, on the work hours and holidays of a calendar.
+     *
+     * The timer starts paused; resume() starts it. The calendar must outlive the timer.
+     */
+    class SlaTimer {
+    public:
+        /**
+         * @brief Constructor, a paused timer with nothing consumed.
+         * @param calendar The calendar the working minutes are counted on.
+         * @param targetMinutes The working minute budget of the service level, not negative.
+         */
+        SlaTimer(WorkdayCalendar* calendar, long long targetMinutes);
+
+        /**
+         * @brief Starts a running segment.
+         * @param epochMinutes The time in minutes since the epoch, not before the last event.
+         * @return False if the timer is already running or the time is invalid.
+         */
+        bool resume(std::int64_t epochMinutes);
+
+        /**
+         * @brief Ends the running segment and adds its working minutes.
+         * @param epochMinutes The time in minutes since the epoch, not before the resume.
+         * @return False if the timer is not running or the time is invalid.
+         */
+        bool pause(std::int64_t epochMinutes);
+
+        /**
+         * @brief Checks if the timer is running.
+         */
+        bool isRunning() const {
+            return running_;
+        }
+
+        /**
+         * @brief Returns the working minutes consumed up to a time.
+         * @param epochMinutes The time in minutes since the epoch; only read while running.
+         * @return The consumed working minutes.
+         */
+        long long getElapsedMinutes(std::int64_t epochMinutes) const;
+
+        /**
+         * @brief Returns the working minutes left of the budget at a time.
+         * @param epochMinutes The time in minutes since the epoch; only read while running.
+         * @return The minutes left, negative once the budget is overrun.
+         */
+        long long getRemainingMinutes(std::int64_t epochMinutes) const {
+            return target_minutes_ - getElapsedMinutes(epochMinutes);
+        }
+
+        /**
+         * @brief Returns the time the budget runs out: projected while running, kept once it has run
+         * out, unknown while paused before that.
+         * @return The time in minutes since the epoch, or INVALID_EPOCH_MINUTES if unknown.
+         */
+        std::int64_t getBreachTime() const {
+            return breach_at_;
+        }
+
+        /**
+         * @brief Serializes the state: a flag byte and four 64-bit little-endian fields.
+         * @return SLA_TIMER_SERIALIZED_SIZE bytes.
+         */
+        std::string serialize() const;
+
+        /**
+         * @brief Restores a serialized timer.
+         * @param calendar The calendar the working minutes are counted on.
+         * @param data The bytes from serialize().
+         * @return The timer, or nothing if the data is malformed.
+         */
+        static std::optional<SlaTimer> deserialize(WorkdayCalendar* calendar, const std::string& data);
+
+    private:
+        WorkdayCalendar* calendar_; ///< Calendar the working minutes are counted on
+        long long target_minutes_; ///< Working minute budget
+        long long elapsed_minutes_; ///< Working minutes of the finished segments
+        bool running_; ///< True between resume and pause
+        std::int64_t last_event_at_; ///< Start of the running segment, or time of the last pause
+        std::int64_t breach_at_; ///< Time the budget runs out, INVALID_EPOCH_MINUTES if unknown
+    };
+
+} // namespace Workday
+
+#endif // SLA_TIMER_H
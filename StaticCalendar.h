@@ -0,0 +1,415 @@
+/**
+ * @file StaticCalendar.h
+ * @brief Header file for the Workday::StaticCalendar class template, a holiday calendar fixed at compile time.
+ *
+ * A StaticCalendar is described by a constexpr HolidayRules value (weekend mask, recurring dates,
+ * n-th weekday rules and one-time dates). The workday bitmap and prefix counts for the configured
+ * years are generated during compilation into static constexpr arrays, so they live in read-only
+ * data, need no heap and no start-up work, and all queries on day serials can be used in
+ * static_assert. Outside the configured years the rules are evaluated directly.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef STATIC_CALENDAR_H
+#define STATIC_CALENDAR_H
+
+#include "BitmapUtils.h"
+#include "Date.h"
+#include "TimeUtils.h"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Workday {
+
+    // Weekend mask with Saturday and Sunday off (bit n set = weekday n is not worked)
+    const unsigned WEEKEND_SATURDAY_SUNDAY = (1u << SUNDAY) | (1u << SATURDAY);
+
+    // n-th value of a WeekdayRule selecting the last such weekday of the month
+    const int LAST_WEEKDAY = -1;
+
+    /**
+     * @brief A holiday on the same month and day every year.
+     */
+    struct RecurringHoliday {
+        int month; ///< Month of the holiday.
+        int day;   ///< Day of the holiday.
+        bool observed = false; ///< Move to Friday when on a Saturday and to Monday when on a Sunday.
+    };
+
+    /**
+     * @brief A holiday on the n-th (or last) given weekday of a month, e.g. the 4th Thursday of November.
+     */
+    struct WeekdayRule {
+        int month;   ///< Month of the holiday.
+        int weekday; ///< Weekday of the holiday (0 = Sunday).
+        int nth;     ///< 1 for the first such weekday, 2 for the second, ..., LAST_WEEKDAY for the last.
+    };
+
+    /**
+     * @brief A one-time holiday.
+     */
+    struct CivilDate {
+        int year;  ///< Year of the holiday.
+        int month; ///< Month of the holiday.
+        int day;   ///< Day of the holiday.
+    };
+
+    /**
+     * @brief Compile-time description of a holiday calendar.
+     * @tparam RecurringCount Number of recurring holidays.
+     * @tparam RuleCount Number of weekday rules.
+     * @tparam DateCount Number of one-time holidays.
+     */
+    template <std::size_t RecurringCount, std::size_t RuleCount = 0, std::size_t DateCount = 0>
+    struct HolidayRules {
+        unsigned weekendMask; ///< Bit n set when weekday n is not worked.
+        std::array<RecurringHoliday, RecurringCount> recurringHolidays; ///< Holidays on fixed dates.
+        std::array<WeekdayRule, RuleCount> weekdayRules; ///< Holidays on n-th weekdays.
+        std::array<CivilDate, DateCount> dates; ///< One-time holidays.
+    };
+
+    /**
+     * @class StaticCalendar
+     * @brief Holiday calendar whose workday bitmap is generated at compile time.
+     *
+     * Besides the constexpr queries on day serials, it offers the Date based operations of Calendar,
+     * so it can back a BasicWorkdayCalendar; holidays cannot be added at run time.
+     *
+     * @tparam Rules The HolidayRules describing the calendar; must have static storage duration.
+     * @tparam FirstYear The first year of the generated bitmap.
+     * @tparam LastYear The last year of the generated bitmap (inclusive).
+     */
+    template <const auto& Rules, int FirstYear, int LastYear>
+    class StaticCalendar {
+        static_assert(FirstYear <= LastYear, "StaticCalendar needs a non-empty year range");
+
+    public:
+        static constexpr int FIRST_DAY = TimeUtils::daysFromCivil(FirstYear, 1, 1); ///< Serial of bit 0.
+        static constexpr int END_DAY = TimeUtils::daysFromCivil(LastYear + 1, 1, 1); ///< Serial past the last bit.
+        static constexpr int DAY_COUNT = END_DAY - FIRST_DAY; ///< Days in the bitmap.
+        static constexpr int WORD_COUNT = BitmapUtils::wordCount(DAY_COUNT); ///< Words in the bitmap.
+
+        /**
+         * @brief Returns the serial of a recurring holiday in a year, after the observance shift.
+         * @return The day serial, or END_OF_TIME when the date does not exist in that year.
+         */
+        static constexpr int holidayDay(int year, const RecurringHoliday& holiday) {
+            if (holiday.day > TimeUtils::daysInMonth(year, holiday.month)) {
+                return END_OF_TIME;
+            }
+            int day = TimeUtils::daysFromCivil(year, holiday.month, holiday.day);
+            if (holiday.observed) {
+                int weekday = TimeUtils::weekdayFromDays(day);
+                day += weekday == SATURDAY ? -1 : weekday == SUNDAY ? 1 : 0;
+            }
+            return day;
+        }
+
+        /**
+         * @brief Returns the serial of a weekday rule in a year.
+         */
+        static constexpr int holidayDay(int year, const WeekdayRule& rule) {
+            if (rule.nth == LAST_WEEKDAY) {
+                int last = TimeUtils::daysFromCivil(year, rule.month, TimeUtils::daysInMonth(year, rule.month));
+                return last - (TimeUtils::weekdayFromDays(last) - rule.weekday + 7) % 7;
+            }
+            int first = TimeUtils::daysFromCivil(year, rule.month, 1);
+            return first + (rule.weekday - TimeUtils::weekdayFromDays(first) + 7) % 7 + 7 * (rule.nth - 1);
+        }
+
+        /**
+         * @brief Evaluates the rules for a day without the bitmap.
+         * @param day The day serial.
+         * @return True if the day is a weekend day or a holiday.
+         */
+        static constexpr bool isHolidayByRules(int day) {
+            if ((Rules.weekendMask >> TimeUtils::weekdayFromDays(day)) & 1u) {
+                return true;
+            }
+            const int year = std::get<0>(TimeUtils::civilFromDays(day));
+            for (const RecurringHoliday& holiday : Rules.recurringHolidays) {
+                // Observance can shift a date across the new year in either direction:
+                // Jan 1 on a Saturday falls on Dec 31, Dec 31 on a Sunday on Jan 1
+                if (holidayDay(year - 1, holiday) == day || holidayDay(year, holiday) == day
+                    || holidayDay(year + 1, holiday) == day) {
+                    return true;
+                }
+            }
+            for (const WeekdayRule& rule : Rules.weekdayRules) {
+                if (holidayDay(year, rule) == day) {
+                    return true;
+                }
+            }
+            for (const CivilDate& date : Rules.dates) {
+                if (TimeUtils::daysFromCivil(date.year, date.month, date.day) == day) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Returns true if the day is a holiday.
+         * @param day The day serial.
+         */
+        static constexpr bool isHoliday(int day) {
+            if (day >= FIRST_DAY && day < END_DAY) {
+                return !BitmapUtils::testBit(TABLES.words, day - FIRST_DAY);
+            }
+            return isHolidayByRules(day);
+        }
+
+        /**
+         * @brief Counts the workdays in [from, to).
+         * @param from The first day serial.
+         * @param to The day serial after the last day.
+         * @return The number of workdays, zero if to is not after from.
+         */
+        static constexpr int countWorkdays(int from, int to) {
+            if (to <= from) {
+                return 0;
+            }
+            int count = 0;
+            int inside_from = from < FIRST_DAY ? FIRST_DAY : from > END_DAY ? END_DAY : from;
+            int inside_to = to < FIRST_DAY ? FIRST_DAY : to > END_DAY ? END_DAY : to;
+            if (inside_from < inside_to) {
+                count = BitmapUtils::rank(TABLES.words, TABLES.prefix, inside_to - FIRST_DAY) -
+                    BitmapUtils::rank(TABLES.words, TABLES.prefix, inside_from - FIRST_DAY);
+            }
+            for (int day = from; day < to && day < FIRST_DAY; ++day) {
+                count += !isHolidayByRules(day);
+            }
+            for (int day = from > END_DAY ? from : END_DAY; day < to; ++day) {
+                count += !isHolidayByRules(day);
+            }
+            return count;
+        }
+
+        /**
+         * @brief Returns the first workday after a day.
+         * @param day The day serial.
+         */
+        static constexpr int nextWorkday(int day) {
+            if (day + 1 >= FIRST_DAY && day + 1 < END_DAY) {
+                int bit = BitmapUtils::nextSetBit(TABLES.words, day + 1 - FIRST_DAY);
+                if (bit >= 0) {
+                    return FIRST_DAY + bit;
+                }
+                day = END_DAY - 1;
+            }
+            do {
+                ++day;
+            } while (isHoliday(day));
+            return day;
+        }
+
+        /**
+         * @brief Returns the last workday before a day.
+         * @param day The day serial.
+         */
+        static constexpr int previousWorkday(int day) {
+            if (day - 1 >= FIRST_DAY && day - 1 < END_DAY) {
+                int bit = BitmapUtils::previousSetBit(TABLES.words, day - 1 - FIRST_DAY);
+                if (bit >= 0) {
+                    return FIRST_DAY + bit;
+                }
+                day = FIRST_DAY;
+            }
+            do {
+                --day;
+            } while (isHoliday(day));
+            return day;
+        }
+
+        /**
+         * @brief Moves a day by a number of workdays.
+         * @param day The day serial.
+         * @param workdays The number of workdays, negative to move backwards.
+         * @return The resulting day serial.
+         */
+        static constexpr int advanceWorkdays(int day, int workdays) {
+            if (workdays != 0 && day >= FIRST_DAY && day < END_DAY) {
+                int offset = day - FIRST_DAY;
+                int target = workdays > 0
+                    ? BitmapUtils::rank(TABLES.words, TABLES.prefix, offset + 1) + workdays - 1
+                    : BitmapUtils::rank(TABLES.words, TABLES.prefix, offset) + workdays;
+                int bit = BitmapUtils::select(TABLES.words, TABLES.prefix, target);
+                if (bit >= 0) {
+                    return FIRST_DAY + bit;
+                }
+            }
+            for (; workdays > 0; --workdays) {
+                day = nextWorkday(day);
+            }
+            for (; workdays < 0; ++workdays) {
+                day = previousWorkday(day);
+            }
+            return day;
+        }
+
+        /**
+         * @brief Day serial names shared with the Calendar interface, used by BasicWorkdayCalendar.
+         */
+        static constexpr bool isHolidayDay(int day) {
+            return isHoliday(day);
+        }
+
+        static constexpr int nextWorkdayDay(int day) {
+            return nextWorkday(day);
+        }
+
+        static constexpr int previousWorkdayDay(int day) {
+            return previousWorkday(day);
+        }
+
+        static constexpr int advanceWorkdaysDay(int day, int workdays) {
+            return advanceWorkdays(day, workdays);
+        }
+
+        static constexpr int countWorkdaysDay(int from, int to) {
+            return countWorkdays(from, to);
+        }
+
+        /**
+         * @brief Returns the generated workday bitmap, bit i standing for day FIRST_DAY + i.
+         */
+        static constexpr std::span<const std::uint64_t> getWords() {
+            return TABLES.words;
+        }
+
+        /**
+         * @brief Returns the generated prefix counts, entry i holding the workdays in words [0, i).
+         */
+        static constexpr std::span<const int> getPrefixCounts() {
+            return TABLES.prefix;
+        }
+
+        /**
+         * @brief Checks if the given date is a holiday.
+         */
+        bool isHoliday(const Date& date) const {
+            return isHoliday(TimeUtils::toDaySerial(date));
+        }
+
+        /**
+         * @brief Checks if the given date is a valid Gregorian date and time.
+         */
+        bool isValidDate(const Date& date) const {
+            return TimeUtils::isValidDate(date);
+        }
+
+        /**
+         * @brief Adds a day to the given date.
+         */
+        void addDay(Date& date) const {
+            TimeUtils::setDaySerial(date, TimeUtils::toDaySerial(date) + 1);
+        }
+
+        /**
+         * @brief Removes a day from the given date.
+         */
+        void removeDay(Date& date) const {
+            TimeUtils::setDaySerial(date, TimeUtils::toDaySerial(date) - 1);
+        }
+
+        /**
+         * @brief Moves the date to the first workday after it.
+         */
+        void nextWorkday(Date& date) const {
+            TimeUtils::setDaySerial(date, nextWorkday(TimeUtils::toDaySerial(date)));
+        }
+
+        /**
+         * @brief Moves the date to the last workday before it.
+         */
+        void previousWorkday(Date& date) const {
+            TimeUtils::setDaySerial(date, previousWorkday(TimeUtils::toDaySerial(date)));
+        }
+
+        /**
+         * @brief Moves the date by a number of workdays.
+         */
+        void advanceWorkdays(Date& date, int workdays) const {
+            TimeUtils::setDaySerial(date, advanceWorkdays(TimeUtils::toDaySerial(date), workdays));
+        }
+
+        /**
+         * @brief Counts the workdays in [from, to).
+         */
+        int countWorkdays(const Date& from, const Date& to) const {
+            return countWorkdays(TimeUtils::toDaySerial(from), TimeUtils::toDaySerial(to));
+        }
+
+        /**
+         * @brief Fills a bit mask of the holidays in [from, to), bit i standing for the i-th day.
+         */
+        void fillHolidayMask(const Date& from, const Date& to, std::vector<std::uint64_t>& out) const {
+            int from_day = TimeUtils::toDaySerial(from);
+            int days = TimeUtils::toDaySerial(to) - from_day;
+            out.assign(BitmapUtils::wordCount(days > 0 ? days : 0), 0);
+            for (int i = 0; i < days; ++i) {
+                if (isHoliday(from_day + i)) {
+                    out[i / BITS_IN_WORD] |= std::uint64_t{ 1 } << (i % BITS_IN_WORD);
+                }
+            }
+        }
+
+    private:
+        static constexpr int END_OF_TIME = 2147483647; ///< Serial used for dates that do not exist.
+
+        /**
+         * @brief Bitmap and prefix counts of the configured years.
+         */
+        struct Tables {
+            std::array<std::uint64_t, WORD_COUNT> words;
+            std::array<int, WORD_COUNT + 1> prefix;
+        };
+
+        /**
+         * @brief Generates the tables: weekdays first, then each year's holidays cleared.
+         */
+        static constexpr Tables buildTables() {
+            Tables tables{};
+            int weekday = TimeUtils::weekdayFromDays(FIRST_DAY);
+            for (int bit = 0; bit < DAY_COUNT; ++bit) {
+                BitmapUtils::setBit(tables.words, bit, !((Rules.weekendMask >> weekday) & 1u));
+                weekday = (weekday + 1) % 7;
+            }
+            auto clear = [&tables](int day) {
+                if (day >= FIRST_DAY && day < END_DAY) {
+                    BitmapUtils::setBit(tables.words, day - FIRST_DAY, false);
+                }
+            };
+            // One year either side catches observed dates shifted across the new year
+            for (int year = FirstYear - 1; year <= LastYear + 1; ++year) {
+                for (const RecurringHoliday& holiday : Rules.recurringHolidays) {
+                    clear(holidayDay(year, holiday));
+                }
+                for (const WeekdayRule& rule : Rules.weekdayRules) {
+                    clear(holidayDay(year, rule));
+                }
+            }
+            for (const CivilDate& date : Rules.dates) {
+                clear(TimeUtils::daysFromCivil(date.year, date.month, date.day));
+            }
+            BitmapUtils::buildPrefixCounts(tables.words, tables.prefix);
+            return tables;
+        }
+
+        static const Tables TABLES; ///< Generated at compile time, stored in read-only data.
+    };
+
+    // Defined outside the class so that buildTables() is complete when it is evaluated
+    template <const auto& Rules, int FirstYear, int LastYear>
+    constexpr typename StaticCalendar<Rules, FirstYear, LastYear>::Tables
+        StaticCalendar<Rules, FirstYear, LastYear>::TABLES = StaticCalendar<Rules, FirstYear, LastYear>::buildTables();
+
+} // namespace Workday
+
+#endif // STATIC_CALENDAR_H
@@ -52,4 +52,25 @@ namespace Workday {
         return hours * MINUTES_IN_HOUR + minutes;
     }
 
+    // **Validates year, month, day, hour, and minute ranges**
+    bool TimeUtils::isValidDate(const Date& date) {
+        int year = date.getYear();
+        int month = date.getMonth();
+        int day = date.getDay();
+        int hour = date.getHours();
+        int minute = date.getMinutes();
+
+        //checking for valid date
+        if (year < 0 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+            return false;
+        }
+
+        //checking for valid time
+        if (hour < 0 || hour >= HOURS_IN_DAY || minute < 0 || minute >= MINUTES_IN_HOUR) {
+            return false;
+        }
+
+        return true;
+    }
+
 } // namespace Workday
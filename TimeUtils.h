@@ -14,6 +14,9 @@
 #ifndef TIME_UTILS_H
 #define TIME_UTILS_H
 
+#include "Date.h"
+#include <chrono>
+#include <cstdint>
 #include <tuple>
 
 namespace Workday {
@@ -24,6 +27,22 @@ namespace Workday {
     const int MINUTES_IN_DAY = MINUTES_IN_HOUR * HOURS_IN_DAY;
     const int SECONDS_IN_HOUR = 3600;
     const int SECONDS_IN_MINUTE = 60;
+    const int DAYS_IN_WEEK = 7;
+
+    // Weekday numbers as returned by Date::dayOfWeek and TimeUtils::weekdayFromDays
+    const int SUNDAY = 0;
+    const int MONDAY = 1;
+    const int TUESDAY = 2;
+    const int WEDNESDAY = 3;
+    const int THURSDAY = 4;
+    const int FRIDAY = 5;
+    const int SATURDAY = 6;
+    const std::int64_t INVALID_EPOCH_MINUTES = INT64_MIN; ///< Returned by the epoch minute queries on failure
+
+    /**
+     * @brief Minute resolution std::chrono time point, counted from 1970-01-01 00:00 like the epoch minutes.
+     */
+    using SysMinutes = std::chrono::sys_time<std::chrono::minutes>;
 
     /**
      * @class TimeUtils
@@ -32,7 +51,8 @@ namespace Workday {
     class TimeUtils {
     public:
         /**
-         * @brief Subtracts two time values represented as tuples of hours and minutes.
+         * @brief Subtracts two time values represented as tuples of hours and minutes. A smaller value
+         * that is later in the day wraps over midnight, so 06:00 - 22:00 is 8 hours.
          * @param larger The larger time value.
          * @param smaller The smaller time value.
          * @return A tuple representing the difference in hours and minutes.
@@ -69,6 +89,225 @@ namespace Workday {
          * @return The time value in minutes.
          */
         static int convertToMinutes(std::tuple<int, int> time_i);
+
+        /**
+         * @brief Checks that a date is a valid Gregorian date and time of day.
+         * @param date The date to check.
+         * @return True if year, month, day, hour and minute are all in range.
+         */
+        static bool isValidDate(const Date& date);
+
+        /**
+         * @brief Checks if the specified year is a Gregorian leap year.
+         * @param year The year to check.
+         * @return True if the year is a leap year, false otherwise.
+         */
+        static constexpr bool isLeapYear(int year) {
+            return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        }
+
+        /**
+         * @brief Returns the number of days in the specified month of the specified year.
+         * @param year The year.
+         * @param month The month (1-12).
+         * @return The number of days in the month.
+         */
+        static constexpr int daysInMonth(int year, int month) {
+            constexpr int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+            return (month == 2 && isLeapYear(year)) ? 29 : days[month - 1];
+        }
+
+        /**
+         * @brief Converts a civil date to a day serial (days since 1970-01-01).
+         * Uses Howard Hinnant's days_from_civil algorithm, valid for the whole proleptic Gregorian calendar.
+         * @param year The year.
+         * @param month The month (1-12).
+         * @param day The day of the month.
+         * @return The number of days since 1970-01-01 (negative before it).
+         */
+        static constexpr int daysFromCivil(int year, int month, int day) {
+            year -= month <= 2;
+            const int era = (year >= 0 ? year : year - 399) / 400;
+            const int yoe = year - era * 400;                                        // [0, 399]
+            const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1; // [0, 365]
+            const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                   // [0, 146096]
+            return era * 146097 + doe - 719468;
+        }
+
+        /**
+         * @brief Converts a day serial (days since 1970-01-01) back to a civil date.
+         * @param days The day serial.
+         * @return A tuple of year, month and day.
+         */
+        static constexpr std::tuple<int, int, int> civilFromDays(int days) {
+            days += 719468;
+            const int era = (days >= 0 ? days : days - 146096) / 146097;
+            const int doe = days - era * 146097;                                     // [0, 146096]
+            const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;   // [0, 399]
+            const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                 // [0, 365]
+            const int mp = (5 * doy + 2) / 153;                                      // [0, 11]
+            const int day = doy - (153 * mp + 2) / 5 + 1;                            // [1, 31]
+            const int month = mp < 10 ? mp + 3 : mp - 9;                             // [1, 12]
+            return { yoe + era * 400 + (month <= 2), month, day };
+        }
+
+        /**
+         * @brief Returns the day of the week for a day serial.
+         * @param days The day serial.
+         * @return The day of the week, where 0 = Sunday, 1 = Monday, ..., 6 = Saturday.
+         */
+        static constexpr int weekdayFromDays(int days) {
+            // 1970-01-01 was a Thursday
+            return days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6;
+        }
+
+        /**
+         * @brief Returns the day serial of the calendar day of a date, ignoring its time.
+         * @param date The date.
+         * @return The number of days since 1970-01-01.
+         */
+        static int toDaySerial(const Date& date) {
+            return daysFromCivil(date.getYear(), date.getMonth(), date.getDay());
+        }
+
+        /**
+         * @brief Moves a date to the calendar day of a day serial, keeping its time.
+         * @param date The date to update.
+         * @param days The day serial.
+         */
+        static void setDaySerial(Date& date, int days) {
+            const auto [year, month, day] = civilFromDays(days);
+            date.setDate(year, month, day, date.getHours(), date.getMinutes());
+        }
+
+        /**
+         * @brief Splits minutes since 1970-01-01 00:00 into a day serial and the minutes of that day.
+         * @param epochMinutes The minutes since the epoch, negative before it.
+         * @param day Output, the day serial.
+         * @param minuteOfDay Output, the minutes since midnight, in [0, MINUTES_IN_DAY).
+         */
+        static constexpr void splitEpochMinutes(std::int64_t epochMinutes, int& day, int& minuteOfDay) {
+            std::int64_t days = epochMinutes / MINUTES_IN_DAY;
+            std::int64_t minutes = epochMinutes % MINUTES_IN_DAY;
+            if (minutes < 0) {
+                minutes += MINUTES_IN_DAY;
+                --days;
+            }
+            day = static_cast<int>(days);
+            minuteOfDay = static_cast<int>(minutes);
+        }
+
+        /**
+         * @brief Joins a day serial and minutes of that day into minutes since 1970-01-01 00:00.
+         * @param day The day serial.
+         * @param minuteOfDay The minutes since midnight.
+         * @return The minutes since the epoch.
+         */
+        static constexpr std::int64_t joinEpochMinutes(int day, int minuteOfDay) {
+            return static_cast<std::int64_t>(day) * MINUTES_IN_DAY + minuteOfDay;
+        }
+
+        /**
+         * @brief Checks that minutes since the epoch fall within the years 0 to 9999.
+         * @param epochMinutes The minutes since the epoch.
+         * @return True if the value can be used by the epoch minute queries.
+         */
+        static constexpr bool isValidEpochMinutes(std::int64_t epochMinutes) {
+            return epochMinutes >= joinEpochMinutes(daysFromCivil(0, 1, 1), 0) &&
+                epochMinutes < joinEpochMinutes(daysFromCivil(10000, 1, 1), 0);
+        }
+
+        /**
+         * @brief Converts a date to minutes since 1970-01-01 00:00.
+         * @param date The date.
+         * @return The minutes since the epoch.
+         */
+        static std::int64_t toEpochMinutes(const Date& date) {
+            return joinEpochMinutes(toDaySerial(date), date.getHours() * MINUTES_IN_HOUR + date.getMinutes());
+        }
+
+        /**
+         * @brief Converts minutes since 1970-01-01 00:00 to a date.
+         * @param epochMinutes The minutes since the epoch.
+         * @return The date.
+         */
+        static Date fromEpochMinutes(std::int64_t epochMinutes) {
+            int day = 0;
+            int minuteOfDay = 0;
+            splitEpochMinutes(epochMinutes, day, minuteOfDay);
+            const auto [year, month, month_day] = civilFromDays(day);
+            return Date(year, month, month_day, minuteOfDay / MINUTES_IN_HOUR, minuteOfDay % MINUTES_IN_HOUR);
+        }
+
+        /**
+         * @brief Converts the calendar day of a date to std::chrono::sys_days, ignoring its time.
+         * @param date The date.
+         * @return The day as a chrono time point.
+         */
+        static std::chrono::sys_days toSysDays(const Date& date) {
+            return std::chrono::sys_days(std::chrono::days(toDaySerial(date)));
+        }
+
+        /**
+         * @brief Converts std::chrono::sys_days to a date at midnight.
+         * @param days The day as a chrono time point.
+         * @return The date.
+         */
+        static Date fromSysDays(std::chrono::sys_days days) {
+            const auto [year, month, day] = civilFromDays(static_cast<int>(days.time_since_epoch().count()));
+            return Date(year, month, day, 0, 0);
+        }
+
+        /**
+         * @brief Converts the calendar day of a date to std::chrono::year_month_day, ignoring its time.
+         * @param date The date.
+         * @return The civil date as chrono fields.
+         */
+        static std::chrono::year_month_day toYearMonthDay(const Date& date) {
+            return std::chrono::year_month_day(std::chrono::year(date.getYear()),
+                std::chrono::month(static_cast<unsigned>(date.getMonth())),
+                std::chrono::day(static_cast<unsigned>(date.getDay())));
+        }
+
+        /**
+         * @brief Converts std::chrono::year_month_day and an optional time of day to a date.
+         * @param ymd The civil date as chrono fields.
+         * @param hour The hour component.
+         * @param minute The minute component.
+         * @return The date.
+         */
+        static Date fromYearMonthDay(std::chrono::year_month_day ymd, int hour = 0, int minute = 0) {
+            return Date(static_cast<int>(ymd.year()), static_cast<int>(static_cast<unsigned>(ymd.month())),
+                static_cast<int>(static_cast<unsigned>(ymd.day())), hour, minute);
+        }
+
+        /**
+         * @brief Converts a date to a minute resolution chrono time point.
+         * @param date The date.
+         * @return The time point.
+         */
+        static SysMinutes toSysMinutes(const Date& date) {
+            return SysMinutes(std::chrono::minutes(toEpochMinutes(date)));
+        }
+
+        /**
+         * @brief Converts a minute resolution chrono time point to a date.
+         * @param time The time point.
+         * @return The date.
+         */
+        static Date fromSysMinutes(SysMinutes time) {
+            return fromEpochMinutes(time.time_since_epoch().count());
+        }
+
+        /**
+         * @brief Sets the time of a date from minutes since midnight, keeping its calendar day.
+         * @param date The date to update.
+         * @param minutes The time of day in minutes since midnight.
+         */
+        static void setMinutesOfDay(Date& date, int minutes) {
+            date.setDate(date.getYear(), date.getMonth(), date.getDay(),
+                minutes / MINUTES_IN_HOUR, minutes % MINUTES_IN_HOUR);
+        }
     };
 
 } // namespace Workday
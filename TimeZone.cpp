@@ -0,0 +1,363 @@
+/**
+ * @file TimeZone.cpp
+ * @brief Implementation file for the TimeZone class, UTC offsets read from the tzdata files.
+ *
+ * This file contains the TZif reader (version 1 and the 64-bit data of versions 2 and later), the
+ * expansion of the POSIX TZ rule of the footer and the offset lookups through the year index.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "TimeZone.h"
+#include "TimeUtils.h"
+#include "logger.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+namespace Workday {
+
+    namespace {
+        const std::size_t TZIF_HEADER_SIZE = 44;
+
+        // Division rounding toward negative infinity, for times before the epoch
+        std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+            std::int64_t quotient = value / divisor;
+            if (value % divisor != 0 && (value < 0) != (divisor < 0)) {
+                --quotient;
+            }
+            return quotient;
+        }
+
+        // Reads a signed big-endian integer of the given size
+        std::int64_t readBigEndian(const std::string& data, std::size_t pos, int bytes) {
+            std::uint64_t value = 0;
+            for (int i = 0; i < bytes; ++i) {
+                value = (value << 8) | static_cast<unsigned char>(data[pos + i]);
+            }
+            if (bytes < 8 && (value >> (bytes * 8 - 1)) & 1u) {
+                value |= ~std::uint64_t{ 0 } << (bytes * 8); // sign extension
+            }
+            return static_cast<std::int64_t>(value);
+        }
+
+        // Parses [+-]hh[:mm[:ss]] into seconds
+        bool parseRuleTime(const std::string& rule, std::size_t& pos, int& seconds) {
+            int sign = 1;
+            if (pos < rule.size() && (rule[pos] == '+' || rule[pos] == '-')) {
+                sign = rule[pos] == '-' ? -1 : 1;
+                ++pos;
+            }
+            int parts[3] = { 0, 0, 0 };
+            for (int part = 0; part < 3; ++part) {
+                if (part > 0) {
+                    if (pos >= rule.size() || rule[pos] != ':') {
+                        break;
+                    }
+                    ++pos;
+                }
+                if (pos >= rule.size() || !std::isdigit(static_cast<unsigned char>(rule[pos]))) {
+                    return false;
+                }
+                while (pos < rule.size() && std::isdigit(static_cast<unsigned char>(rule[pos]))) {
+                    parts[part] = parts[part] * 10 + (rule[pos++] - '0');
+                }
+            }
+            seconds = sign * (parts[0] * SECONDS_IN_HOUR + parts[1] * SECONDS_IN_MINUTE + parts[2]);
+            return true;
+        }
+
+        // Skips a zone abbreviation, either alphabetic or quoted in angle brackets
+        bool skipRuleName(const std::string& rule, std::size_t& pos) {
+            const std::size_t start = pos;
+            if (pos < rule.size() && rule[pos] == '<') {
+                pos = rule.find('>', pos);
+                if (pos == std::string::npos) {
+                    return false;
+                }
+                ++pos;
+                return true;
+            }
+            while (pos < rule.size() && std::isalpha(static_cast<unsigned char>(rule[pos]))) {
+                ++pos;
+            }
+            return pos > start;
+        }
+
+        /**
+         * @brief Date part of a rule: the d-th weekday (0 = Sunday) of week w (5 = last) of month m,
+         * and the local time of the change in seconds.
+         */
+        struct RuleDate {
+            int month;
+            int week;
+            int weekday;
+            int seconds;
+        };
+
+        // Parses Mm.w.d[/time]
+        bool parseRuleDate(const std::string& rule, std::size_t& pos, RuleDate& date) {
+            if (pos >= rule.size() || rule[pos] != 'M') {
+                return false; // the Julian day forms are not used by current tzdata
+            }
+            ++pos;
+            int* fields[3] = { &date.month, &date.week, &date.weekday };
+            for (int field = 0; field < 3; ++field) {
+                if (field > 0) {
+                    if (pos >= rule.size() || rule[pos] != '.') {
+                        return false;
+                    }
+                    ++pos;
+                }
+                if (pos >= rule.size() || !std::isdigit(static_cast<unsigned char>(rule[pos]))) {
+                    return false;
+                }
+                *fields[field] = 0;
+                while (pos < rule.size() && std::isdigit(static_cast<unsigned char>(rule[pos]))) {
+                    *fields[field] = *fields[field] * 10 + (rule[pos++] - '0');
+                }
+            }
+            date.seconds = 2 * SECONDS_IN_HOUR;
+            if (pos < rule.size() && rule[pos] == '/') {
+                ++pos;
+                if (!parseRuleTime(rule, pos, date.seconds)) {
+                    return false;
+                }
+            }
+            return date.month >= 1 && date.month <= 12 && date.week >= 1 && date.week <= 5 &&
+                date.weekday >= SUNDAY && date.weekday <= SATURDAY;
+        }
+
+        // Day serial of the rule date in a year
+        int ruleDay(const RuleDate& date, int year) {
+            const int first = TimeUtils::daysFromCivil(year, date.month, 1);
+            int day = first + (date.weekday - TimeUtils::weekdayFromDays(first) + DAYS_IN_WEEK) % DAYS_IN_WEEK +
+                (date.week - 1) * DAYS_IN_WEEK;
+            while (day >= first + TimeUtils::daysInMonth(year, date.month)) {
+                day -= DAYS_IN_WEEK; // week 5 is the last such weekday of the month
+            }
+            return day;
+        }
+    }
+
+    // **Constructor - a zone without transitions at UTC**
+    TimeZone::TimeZone(const std::string& name)
+        : name_(name), initial_offset_(0), transitions_(), offsets_(), first_year_(0), year_index_() {}
+
+    // **Reads the file and parses it**
+    std::optional<TimeZone> TimeZone::load(const std::string& name, const std::string& directory) {
+        try {
+            std::ifstream file(directory + "/" + name, std::ios::binary);
+            if (!file) {
+                Logger::getInstance().logInfo("Time zone file not found: " + name, LOG_LOCATION);
+                return std::nullopt;
+            }
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            return parse(name, contents.str());
+        }
+        catch (std::exception e) {
+            Logger::getInstance().logError(e.what(), LOG_LOCATION);
+            return std::nullopt;
+        }
+    }
+
+    // **Reads the header counts, the transitions and local time types, then the footer rule**
+    std::optional<TimeZone> TimeZone::parse(const std::string& name, const std::string& data) {
+        if (data.size() < TZIF_HEADER_SIZE || data.compare(0, 4, "TZif") != 0) {
+            Logger::getInstance().logInfo("Invalid time zone data: " + name, LOG_LOCATION);
+            return std::nullopt;
+        }
+
+        // Counts: UT/local indicators, standard/wall indicators, leap seconds, transitions, types, characters
+        auto readCounts = [&data](std::size_t header, std::int64_t counts[6]) {
+            bool valid = true;
+            for (int i = 0; i < 6; ++i) {
+                counts[i] = readBigEndian(data, header + 20 + 4 * i, 4);
+                valid = valid && counts[i] >= 0;
+            }
+            return valid;
+        };
+        auto blockSize = [](const std::int64_t counts[6], int timeSize) {
+            return counts[3] * timeSize + counts[3] + counts[4] * 6 + counts[5] + counts[2] * (timeSize + 4) +
+                counts[1] + counts[0];
+        };
+
+        std::int64_t counts[6];
+        if (!readCounts(0, counts)) {
+            Logger::getInstance().logInfo("Invalid time zone data: " + name, LOG_LOCATION);
+            return std::nullopt;
+        }
+        std::size_t header = 0;
+        int time_size = 4;
+        const bool has_footer = data[4] >= '2';
+        if (has_footer) {
+            // Skip the 32-bit data, the 64-bit data follows with its own header
+            header = TZIF_HEADER_SIZE + static_cast<std::size_t>(blockSize(counts, 4));
+            if (data.size() < header + TZIF_HEADER_SIZE || data.compare(header, 4, "TZif") != 0 ||
+                !readCounts(header, counts)) {
+                Logger::getInstance().logInfo("Invalid time zone data: " + name, LOG_LOCATION);
+                return std::nullopt;
+            }
+            time_size = 8;
+        }
+        const std::size_t block = header + TZIF_HEADER_SIZE;
+        const std::size_t block_end = block + static_cast<std::size_t>(blockSize(counts, time_size));
+        if (counts[4] < 1 || data.size() < block_end) {
+            Logger::getInstance().logInfo("Invalid time zone data: " + name, LOG_LOCATION);
+            return std::nullopt;
+        }
+
+        const std::int64_t transition_count = counts[3];
+        const std::size_t type_indexes = block + static_cast<std::size_t>(transition_count * time_size);
+        const std::size_t types = type_indexes + static_cast<std::size_t>(transition_count);
+        auto offsetOfType = [&](std::int64_t type) {
+            return static_cast<int>(floorDiv(readBigEndian(data, types + static_cast<std::size_t>(type) * 6, 4),
+                SECONDS_IN_MINUTE));
+        };
+
+        TimeZone zone(name);
+        zone.initial_offset_ = offsetOfType(0);
+        const std::int64_t earliest = TimeUtils::joinEpochMinutes(TimeUtils::daysFromCivil(0, 1, 1), 0);
+        for (std::int64_t i = 0; i < transition_count; ++i) {
+            const std::int64_t type = static_cast<unsigned char>(data[type_indexes + static_cast<std::size_t>(i)]);
+            if (type >= counts[4]) {
+                Logger::getInstance().logInfo("Invalid time zone data: " + name, LOG_LOCATION);
+                return std::nullopt;
+            }
+            const std::int64_t minutes = floorDiv(readBigEndian(data, block + static_cast<std::size_t>(i * time_size),
+                time_size), SECONDS_IN_MINUTE);
+            const int offset = offsetOfType(type);
+            if (minutes < earliest) {
+                zone.initial_offset_ = offset; // before any date the calendars accept
+                continue;
+            }
+            // Changes of abbreviation or DST flag alone do not move the clocks
+            if (offset == (zone.offsets_.empty() ? zone.initial_offset_ : zone.offsets_.back())) {
+                continue;
+            }
+            zone.transitions_.push_back(minutes);
+            zone.offsets_.push_back(offset);
+        }
+
+        if (has_footer && block_end < data.size() && data[block_end] == '\n') {
+            const std::size_t rule_end = data.find('\n', block_end + 1);
+            const std::string rule = data.substr(block_end + 1,
+                rule_end == std::string::npos ? std::string::npos : rule_end - block_end - 1);
+            if (!rule.empty() && !zone.expandRule(rule)) {
+                Logger::getInstance().logInfo("Unsupported time zone rule: " + rule, LOG_LOCATION);
+            }
+        }
+        zone.buildYearIndex();
+        return zone;
+    }
+
+    // **Adds the yearly DST changes of the rule after the last transition of the file**
+    bool TimeZone::expandRule(const std::string& rule) {
+        std::size_t pos = 0;
+        int std_seconds = 0;
+        if (!skipRuleName(rule, pos) || !parseRuleTime(rule, pos, std_seconds)) {
+            return false;
+        }
+        if (pos == rule.size()) {
+            return true; // no DST, the offset of the last transition stays
+        }
+
+        // POSIX offsets count west of Greenwich, UTC offsets east
+        const int std_offset = -std_seconds;
+        int dst_offset = std_offset + SECONDS_IN_HOUR;
+        if (!skipRuleName(rule, pos)) {
+            return false;
+        }
+        if (pos < rule.size() && rule[pos] != ',') {
+            int dst_seconds = 0;
+            if (!parseRuleTime(rule, pos, dst_seconds)) {
+                return false;
+            }
+            dst_offset = -dst_seconds;
+        }
+        RuleDate start{};
+        RuleDate end{};
+        if (pos >= rule.size() || rule[pos++] != ',' || !parseRuleDate(rule, pos, start) ||
+            pos >= rule.size() || rule[pos++] != ',' || !parseRuleDate(rule, pos, end) || pos != rule.size()) {
+            return false;
+        }
+
+        const std::int64_t last = transitions_.empty() ? INT64_MIN : transitions_.back();
+        const int first_year = transitions_.empty() ? 1970 : std::get<0>(TimeUtils::civilFromDays(
+            static_cast<int>(floorDiv(last, MINUTES_IN_DAY))));
+        for (int year = first_year; year <= TIME_ZONE_LAST_YEAR; ++year) {
+            // DST starts at a standard local time and ends at a daylight local time
+            std::pair<std::int64_t, int> changes[2] = {
+                { TimeUtils::joinEpochMinutes(ruleDay(start, year), 0) +
+                    floorDiv(start.seconds - std_offset, SECONDS_IN_MINUTE), floorDiv(dst_offset, SECONDS_IN_MINUTE) },
+                { TimeUtils::joinEpochMinutes(ruleDay(end, year), 0) +
+                    floorDiv(end.seconds - dst_offset, SECONDS_IN_MINUTE), floorDiv(std_offset, SECONDS_IN_MINUTE) } };
+            if (changes[1].first < changes[0].first) {
+                std::swap(changes[0], changes[1]); // southern hemisphere
+            }
+            for (const auto& [minutes, offset] : changes) {
+                if (minutes > (transitions_.empty() ? last : transitions_.back()) &&
+                    offset != (offsets_.empty() ? initial_offset_ : offsets_.back())) {
+                    transitions_.push_back(minutes);
+                    offsets_.push_back(offset);
+                }
+            }
+        }
+        return true;
+    }
+
+    // **First transition at or after January 1 of every year spanned by the transitions**
+    void TimeZone::buildYearIndex() {
+        year_index_.clear();
+        if (transitions_.empty()) {
+            return;
+        }
+        first_year_ = std::get<0>(TimeUtils::civilFromDays(static_cast<int>(floorDiv(transitions_.front(), MINUTES_IN_DAY))));
+        const int last_year = std::get<0>(TimeUtils::civilFromDays(static_cast<int>(floorDiv(transitions_.back(), MINUTES_IN_DAY))));
+        for (int year = first_year_; year <= last_year + 1; ++year) {
+            const std::int64_t january = TimeUtils::joinEpochMinutes(TimeUtils::daysFromCivil(year, 1, 1), 0);
+            year_index_.push_back(static_cast<std::size_t>(
+                std::lower_bound(transitions_.begin(), transitions_.end(), january) - transitions_.begin()));
+        }
+    }
+
+    // **Starts at the year's first transition and steps over the few transitions of that year**
+    std::size_t TimeZone::firstTransitionAfter(std::int64_t utcMinutes) const {
+        if (!year_index_.empty()) {
+            const int year = std::get<0>(TimeUtils::civilFromDays(static_cast<int>(floorDiv(utcMinutes, MINUTES_IN_DAY))));
+            if (year >= first_year_ && year - first_year_ < static_cast<int>(year_index_.size())) {
+                std::size_t index = year_index_[year - first_year_];
+                while (index < transitions_.size() && transitions_[index] <= utcMinutes) {
+                    ++index;
+                }
+                return index;
+            }
+        }
+        return static_cast<std::size_t>(
+            std::upper_bound(transitions_.begin(), transitions_.end(), utcMinutes) - transitions_.begin());
+    }
+
+    // **Offset of the last transition at or before the time**
+    int TimeZone::getOffsetMinutes(std::int64_t utcMinutes) const {
+        return getOffsetBefore(firstTransitionAfter(utcMinutes));
+    }
+
+    // **Tries the offset of the day before, then of the day after; neither fits inside a gap**
+    std::int64_t TimeZone::toUtc(std::int64_t localMinutes) const {
+        const int earlier = getOffsetMinutes(localMinutes - MINUTES_IN_DAY);
+        if (getOffsetMinutes(localMinutes - earlier) == earlier) {
+            return localMinutes - earlier;
+        }
+        const int later = getOffsetMinutes(localMinutes + MINUTES_IN_DAY);
+        if (getOffsetMinutes(localMinutes - later) == later) {
+            return localMinutes - later;
+        }
+        return localMinutes - earlier;
+    }
+
+} // namespace Workday
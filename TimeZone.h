@@ -0,0 +1,153 @@
+/**
+ * @file TimeZone.h
+ * @brief Header file for the Workday::TimeZone class, UTC offsets read from the tzdata files.
+ *
+ * A zone is loaded once from its TZif file (RFC 8536, e.g. /usr/share/zoneinfo/Europe/Berlin). The
+ * transitions are kept as a sorted array of UTC epoch minutes with the UTC offset in force from each
+ * one, and the rule in the file's footer is expanded into transitions up to TIME_ZONE_LAST_YEAR.
+ * A per-year index points at the first transition of every year, so an offset lookup scans the
+ * couple of transitions of one year instead of searching the array or reading the file again.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef TIME_ZONE_H
+#define TIME_ZONE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Workday {
+
+    // Directory holding the tzdata files
+    const char* const DEFAULT_ZONEINFO_DIRECTORY = "/usr/share/zoneinfo";
+
+    // Last year the footer rule of a zone is expanded to
+    const int TIME_ZONE_LAST_YEAR = 2100;
+
+    /**
+     * @class TimeZone
+     * @brief UTC offsets and transitions of one time zone, with conversions between UTC and local epoch minutes.
+     */
+    class TimeZone {
+    public:
+        /**
+         * @brief Reads a zone from its TZif file.
+         * @param name The zone name, e.g. "Europe/Berlin".
+         * @param directory The tzdata directory.
+         * @return The zone, or nothing if the file is missing or cannot be parsed.
+         */
+        static std::optional<TimeZone> load(const std::string& name,
+            const std::string& directory = DEFAULT_ZONEINFO_DIRECTORY);
+
+        /**
+         * @brief Parses a zone from the contents of a TZif file.
+         * @param name The zone name.
+         * @param data The file contents.
+         * @return The zone, or nothing if the data cannot be parsed.
+         */
+        static std::optional<TimeZone> parse(const std::string& name, const std::string& data);
+
+        /**
+         * @brief Returns the zone name.
+         */
+        const std::string& getName() const {
+            return name_;
+        }
+
+        /**
+         * @brief Returns the UTC offset in minutes in force at a UTC time.
+         * @param utcMinutes The time in minutes since 1970-01-01 00:00 UTC.
+         */
+        int getOffsetMinutes(std::int64_t utcMinutes) const;
+
+        /**
+         * @brief Converts a UTC time to local time.
+         * @param utcMinutes The time in minutes since 1970-01-01 00:00 UTC.
+         * @return The local time in minutes since 1970-01-01 00:00 local.
+         */
+        std::int64_t toLocal(std::int64_t utcMinutes) const {
+            return utcMinutes + getOffsetMinutes(utcMinutes);
+        }
+
+        /**
+         * @brief Converts a local time to UTC. A local time repeated when the clocks go back resolves to
+         * its first occurrence; a local time skipped when the clocks go forward is moved forward by the gap.
+         * @param localMinutes The time in minutes since 1970-01-01 00:00 local.
+         * @return The time in minutes since 1970-01-01 00:00 UTC.
+         */
+        std::int64_t toUtc(std::int64_t localMinutes) const;
+
+        /**
+         * @brief Returns the index of the first transition after a UTC time.
+         * @param utcMinutes The time in minutes since 1970-01-01 00:00 UTC.
+         */
+        std::size_t firstTransitionAfter(std::int64_t utcMinutes) const;
+
+        /**
+         * @brief Returns the number of transitions.
+         */
+        std::size_t getTransitionCount() const {
+            return transitions_.size();
+        }
+
+        /**
+         * @brief Returns the UTC time of a transition in epoch minutes.
+         * @param index The transition index.
+         */
+        std::int64_t getTransition(std::size_t index) const {
+            return transitions_[index];
+        }
+
+        /**
+         * @brief Returns the UTC offset in minutes in force before a transition.
+         * @param index The transition index.
+         */
+        int getOffsetBefore(std::size_t index) const {
+            return index == 0 ? initial_offset_ : offsets_[index - 1];
+        }
+
+        /**
+         * @brief Returns the UTC offset in minutes in force from a transition on.
+         * @param index The transition index.
+         */
+        int getOffsetAfter(std::size_t index) const {
+            return offsets_[index];
+        }
+
+    private:
+        /**
+         * @brief Constructor, only reachable through load() and parse().
+         * @param name The zone name.
+         */
+        explicit TimeZone(const std::string& name);
+
+        /**
+         * @brief Expands a POSIX TZ rule ("CET-1CEST,M3.5.0,M10.5.0/3") into transitions after the
+         * last one read from the file, up to TIME_ZONE_LAST_YEAR.
+         * @param rule The rule from the file footer.
+         * @return False if the rule cannot be parsed.
+         */
+        bool expandRule(const std::string& rule);
+
+        /**
+         * @brief Builds the per-year index over the transitions.
+         */
+        void buildYearIndex();
+
+        std::string name_; ///< Zone name
+        int initial_offset_; ///< Offset before the first transition, in minutes
+        std::vector<std::int64_t> transitions_; ///< Sorted UTC times of the transitions, in epoch minutes
+        std::vector<int> offsets_; ///< Offset from each transition on, in minutes
+        int first_year_; ///< First year of the year index
+        std::vector<std::size_t> year_index_; ///< First transition at or after January 1 of each year
+    };
+
+} // namespace Workday
+
+#endif // TIME_ZONE_H
@@ -0,0 +1,27 @@
+/**
+ * @file ValidDate.cpp
+ * @brief Implementation file for the ValidDate class, a date that is known to be valid.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "ValidDate.h"
+#include "TimeUtils.h"
+
+namespace Workday {
+
+    // **Constructor - stores an already validated date**
+    ValidDate::ValidDate(const Date& date) : date_(date) {}
+
+    // **Checked factory - wraps the date only if it is valid**
+    std::optional<ValidDate> ValidDate::create(const Date& date) {
+        if (!TimeUtils::isValidDate(date)) {
+            return std::nullopt;
+        }
+        return ValidDate(date);
+    }
+
+} // namespace Workday
@@ -0,0 +1,55 @@
+/**
+ * @file ValidDate.h
+ * @brief Header file for the Workday::ValidDate class, a date that is known to be valid.
+ *
+ * A ValidDate can only be obtained through the checked factory create(), so holding one proves the
+ * date passed the Gregorian range checks. Query overloads taking a ValidDate skip the per-call
+ * isValidDate check, which lets bulk callers validate a column of dates once and reuse the result.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef VALID_DATE_H
+#define VALID_DATE_H
+
+#include "Date.h"
+#include <optional>
+
+namespace Workday {
+
+    /**
+     * @class ValidDate
+     * @brief Wraps a Date that has passed validation.
+     */
+    class ValidDate {
+    public:
+        /**
+         * @brief Validates a date and wraps it.
+         * @param date The date to validate.
+         * @return The validated date, or nothing if the date is not valid.
+         */
+        static std::optional<ValidDate> create(const Date& date);
+
+        /**
+         * @brief Returns the wrapped date.
+         */
+        const Date& getDate() const {
+            return date_;
+        }
+
+    private:
+        /**
+         * @brief Constructor, only reachable through create().
+         * @param date The already validated date.
+         */
+        explicit ValidDate(const Date& date);
+
+        Date date_; ///< The validated date
+    };
+
+} // namespace Workday
+
+#endif // VALID_DATE_H
@@ -0,0 +1,86 @@
+/**
+ * @file WeeklySchedule.cpp
+ * @brief Implementation file for the WeeklySchedule class, per-weekday working intervals.
+ *
+ * This file contains the insertion of intervals, which keeps the cumulative working minutes of each
+ * weekday up to date, and the lookups between times of day and working minutes.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "WeeklySchedule.h"
+#include "logger.h"
+#include <algorithm>
+#include <iterator>
+
+namespace Workday {
+
+    // **Default constructor - no working time on any weekday**
+    WeeklySchedule::WeeklySchedule() : intervals_(), daily_minutes_(), weekly_minutes_(0) {}
+
+    // **Inserts the interval in order and rebuilds the weekday's cumulative minutes**
+    void WeeklySchedule::addInterval(int weekday, int startMinutes, int stopMinutes) {
+        if (weekday < SUNDAY || weekday > SATURDAY) {
+            Logger::getInstance().logInfo("Invalid weekday", LOG_LOCATION);
+            return;
+        }
+        if (startMinutes < 0 || startMinutes >= stopMinutes || stopMinutes > MINUTES_IN_DAY) {
+            Logger::getInstance().logInfo("Invalid interval", LOG_LOCATION);
+            return;
+        }
+
+        std::vector<Interval>& intervals = intervals_[weekday];
+        auto it = std::lower_bound(intervals.begin(), intervals.end(), startMinutes,
+            [](const Interval& interval, int start) { return interval.start < start; });
+        if ((it != intervals.end() && it->start < stopMinutes) ||
+            (it != intervals.begin() && std::prev(it)->stop > startMinutes)) {
+            Logger::getInstance().logInfo("Overlapping interval", LOG_LOCATION);
+            return;
+        }
+        intervals.insert(it, Interval{ startMinutes, stopMinutes, 0 });
+
+        int worked = 0;
+        for (Interval& interval : intervals) {
+            interval.worked_before = worked;
+            worked += interval.stop - interval.start;
+        }
+        weekly_minutes_ += worked - daily_minutes_[weekday];
+        daily_minutes_[weekday] = worked;
+    }
+
+    // **Cumulative minutes of the interval holding the time, plus the part of it already passed**
+    int WeeklySchedule::workedBefore(int weekday, int minuteOfDay) const {
+        int worked = 0;
+        for (const Interval& interval : intervals_[weekday]) {
+            if (minuteOfDay <= interval.start) {
+                break;
+            }
+            worked = interval.worked_before + std::min(minuteOfDay, interval.stop) - interval.start;
+        }
+        return worked;
+    }
+
+    // **First interval whose cumulative end reaches the worked minutes**
+    int WeeklySchedule::minuteAfterWorked(int weekday, int workedMinutes) const {
+        for (const Interval& interval : intervals_[weekday]) {
+            if (workedMinutes <= interval.worked_before + interval.stop - interval.start) {
+                return interval.start + workedMinutes - interval.worked_before;
+            }
+        }
+        return intervals_[weekday].empty() ? 0 : intervals_[weekday].back().stop;
+    }
+
+    // **First interval whose cumulative end passes the worked minutes**
+    int WeeklySchedule::minuteBeforeRemaining(int weekday, int workedMinutes) const {
+        for (const Interval& interval : intervals_[weekday]) {
+            if (workedMinutes < interval.worked_before + interval.stop - interval.start) {
+                return interval.start + workedMinutes - interval.worked_before;
+            }
+        }
+        return intervals_[weekday].empty() ? 0 : intervals_[weekday].back().stop;
+    }
+
+} // namespace Workday
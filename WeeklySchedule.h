@@ -0,0 +1,110 @@
+/**
+ * @file WeeklySchedule.h
+ * @brief Header file for the Workday::WeeklySchedule class, per-weekday working intervals.
+ *
+ * A weekly schedule lists the working intervals of each weekday, e.g. 08:00-12:00 and 12:30-16:00
+ * from Monday to Thursday and 08:00-13:00 on Friday. Every interval keeps the working minutes of
+ * its weekday before it, so moving a number of working minutes within a day is a lookup into that
+ * cumulative table rather than a comparison against a single start/stop window.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef WEEKLY_SCHEDULE_H
+#define WEEKLY_SCHEDULE_H
+
+#include "TimeUtils.h"
+#include <array>
+#include <vector>
+
+namespace Workday {
+
+    /**
+     * @class WeeklySchedule
+     * @brief Working intervals for each day of the week.
+     */
+    class WeeklySchedule {
+    public:
+        /**
+         * @brief Default constructor, creates a schedule without working time.
+         */
+        WeeklySchedule();
+
+        /**
+         * @brief Adds a working interval to a weekday. Invalid or overlapping intervals are logged and ignored.
+         * @param weekday The weekday, SUNDAY (0) to SATURDAY (6).
+         * @param startMinutes Start of the interval in minutes since midnight.
+         * @param stopMinutes Stop of the interval in minutes since midnight.
+         */
+        void addInterval(int weekday, int startMinutes, int stopMinutes);
+
+        /**
+         * @brief Returns the working minutes of a weekday.
+         * @param weekday The weekday.
+         */
+        int getWorkingMinutes(int weekday) const {
+            return daily_minutes_[weekday];
+        }
+
+        /**
+         * @brief Returns the working minutes of each weekday, indexed by weekday.
+         */
+        const std::array<int, DAYS_IN_WEEK>& getDailyMinutes() const {
+            return daily_minutes_;
+        }
+
+        /**
+         * @brief Returns the working minutes of the whole week.
+         */
+        int getWeeklyMinutes() const {
+            return weekly_minutes_;
+        }
+
+        /**
+         * @brief Counts the working minutes of a weekday before a time of day.
+         * @param weekday The weekday.
+         * @param minuteOfDay The time in minutes since midnight.
+         * @return The working minutes in [00:00, minuteOfDay).
+         */
+        int workedBefore(int weekday, int minuteOfDay) const;
+
+        /**
+         * @brief Finds the time at which a number of working minutes of a weekday have elapsed.
+         * The result is the earliest such time, so it lies at the end of an interval rather than at
+         * the start of the next one.
+         * @param weekday The weekday.
+         * @param workedMinutes The working minutes, in (0, getWorkingMinutes(weekday)].
+         * @return The time in minutes since midnight.
+         */
+        int minuteAfterWorked(int weekday, int workedMinutes) const;
+
+        /**
+         * @brief Finds the latest time at which a number of working minutes of a weekday have elapsed.
+         * The result lies at the start of an interval rather than at the end of the previous one.
+         * @param weekday The weekday.
+         * @param workedMinutes The working minutes, in [0, getWorkingMinutes(weekday)).
+         * @return The time in minutes since midnight.
+         */
+        int minuteBeforeRemaining(int weekday, int workedMinutes) const;
+
+    private:
+        /**
+         * @brief A working interval and the working minutes of its weekday before it.
+         */
+        struct Interval {
+            int start;         ///< Start in minutes since midnight
+            int stop;          ///< Stop in minutes since midnight
+            int worked_before; ///< Working minutes of the weekday before start
+        };
+
+        std::array<std::vector<Interval>, DAYS_IN_WEEK> intervals_; ///< Sorted intervals per weekday
+        std::array<int, DAYS_IN_WEEK> daily_minutes_; ///< Working minutes per weekday
+        int weekly_minutes_; ///< Working minutes per week
+    };
+
+} // namespace Workday
+
+#endif // WEEKLY_SCHEDULE_H
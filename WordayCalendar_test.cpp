@@ -1,6 +1,17 @@
 ﻿#define GTEST_USE_OWN_TR1_TUPLE 1
 #include <gtest/gtest.h>
+#include "CombinedCalendar.h"
+#include "FiscalCalendar.h"
+#include "FollowTheSun.h"
+#include "MinuteMaskCalendar.h"
+#include "PaymentSchedule.h"
+#include "RotatingCalendar.h"
+#include "SlaTimer.h"
+#include "StaticCalendar.h"
+#include "TimeZone.h"
 #include "WorkdayCalendar.h"
+#include <algorithm>
+#include <cmath>
 #include <thread>
 
 using namespace Workday;
@@ -148,7 +159,40 @@ TEST_P(CalculateWorkdayIncrementTest, WorkdayIncrementTest) {
     EXPECT_EQ(returnDate.getDateAndTime(), as.expectedReturnDate.getDateAndTime());
 }
 
-//Use below dates as start and end of work day
+TEST_P(CalculateWorkdayIncrementTest, FixedHoursWorkdayIncrementTest) {
+    auto as = GetParam();
+    // All cases use 08:00-16:00, which the fixed-hours calendar has built in
+    FixedHoursWorkdayCalendar<8 * MINUTES_IN_HOUR, 16 * MINUTES_IN_HOUR> fixed_calendar;
+    if (as.setHolday) {
+        fixed_calendar.setHoliday(as.holiday);
+    }
+
+    if (as.setRecHolday) {
+        fixed_calendar.setRecurringHoliday(as.recuringHoliday);
+    }
+
+    Date returnDate = fixed_calendar.getWorkdayIncrement(as.startDate, as.increment);
+    EXPECT_EQ(returnDate.getDateAndTime(), as.expectedReturnDate.getDateAndTime());
+}
+
+TEST_P(CalculateWorkdayIncrementTest, ValidDateWorkdayIncrementTest) {
+    auto as = GetParam();
+    workday_calendar->setWorkdayStartAndStop(as.workdayStart, as.workdayStop);
+    if (as.setHolday) {
+        workday_calendar->setHoliday(as.holiday);
+    }
+
+    if (as.setRecHolday) {
+        workday_calendar->setRecurringHoliday(as.recuringHoliday);
+    }
+
+    std::optional<ValidDate> start = ValidDate::create(as.startDate);
+    ASSERT_TRUE(start.has_value());
+    Date returnDate = workday_calendar->getWorkdayIncrement(*start, as.increment);
+    EXPECT_EQ(returnDate.getDateAndTime(), as.expectedReturnDate.getDateAndTime());
+}
+
+
 Date startWorkday = Date(2004, 1, 1, 8, 0);
 Date stopWorkday = Date(2004, 1, 1, 16, 0);
 Date invalid = stopWorkday.generateInvalidDate();
@@ -212,6 +256,1067 @@ INSTANTIATE_TEST_SUITE_P(default, CalculateWorkdayIncrementTest,
 ),TestNameGenerator);
 
 
+// Test case for the statically bound Gregorian workday calendar giving the same results
+TEST(GregorianWorkdayCalendarTest, MatchesTypeErasedCalendar) {
+    GregorianWorkdayCalendar static_calendar;
+    WorkdayCalendar erased_calendar;
+    static_calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    erased_calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    static_calendar.setHoliday(Date(2004, 5, 27, 0, 0));
+    erased_calendar.setHoliday(Date(2004, 5, 27, 0, 0));
+    static_calendar.setRecurringHoliday(Date(2004, 5, 17, 0, 0));
+    erased_calendar.setRecurringHoliday(Date(2004, 5, 17, 0, 0));
+
+    Date start_date(2004, 5, 24, 19, 3);
+    for (float increment : { 44.723656f, -6.7470217f, 0.25f }) {
+        EXPECT_EQ(static_calendar.getWorkdayIncrement(start_date, increment).getDateAndTime(),
+            erased_calendar.getWorkdayIncrement(start_date, increment).getDateAndTime());
+    }
+    EXPECT_EQ(static_calendar.getWorkdayIncrement(start_date, 44.723656f).getDateAndTime(),
+        Date(2004, 7, 27, 13, 47).getDateAndTime());
+}
+
+// Test case for the range operations of the Gregorian calendar against the default implementations
+TEST(GregorianCalendarTest, RangeOperationsMatchDefaults) {
+    GregorianCalendar calendar;
+    calendar.setHoliday(Date(2024, 7, 4, 0, 0));
+    calendar.setRecurringHoliday(Date(2024, 12, 25, 0, 0));
+    const Calendar& base = calendar;
+
+    // Inside the indexed years, before them and after them
+    for (Date from : { Date(2024, 6, 28, 9, 0), Date(1969, 12, 20, 9, 0), Date(2099, 12, 20, 9, 0) }) {
+        Date to = from;
+        calendar.advanceWorkdays(to, 40);
+        EXPECT_EQ(calendar.countWorkdays(from, to), base.Calendar::countWorkdays(from, to));
+
+        for (int workdays : { 1, 7, 40, -1, -7, -40 }) {
+            Date expected = from;
+            Date actual = from;
+            base.Calendar::advanceWorkdays(expected, workdays);
+            calendar.advanceWorkdays(actual, workdays);
+            EXPECT_EQ(actual.getDateAndTime(), expected.getDateAndTime());
+        }
+
+        std::vector<std::uint64_t> expected_mask;
+        std::vector<std::uint64_t> actual_mask;
+        base.Calendar::fillHolidayMask(from, to, expected_mask);
+        calendar.fillHolidayMask(from, to, actual_mask);
+        EXPECT_EQ(actual_mask, expected_mask);
+
+        const std::array<int, DAYS_IN_WEEK> weekday_minutes{ 0, 450, 450, 460, 450, 300, 60 };
+        const int from_day = TimeUtils::toDaySerial(from);
+        EXPECT_EQ(calendar.countWeekdayMinutes(from_day - 400, from_day + 400, weekday_minutes),
+            base.Calendar::countWeekdayMinutes(from_day - 400, from_day + 400, weekday_minutes));
+    }
+
+    // Next and previous workday skip the weekend and the holiday
+    Date date(2024, 7, 3, 10, 30);
+    calendar.nextWorkday(date);
+    EXPECT_EQ(date.getDateAndTime(), Date(2024, 7, 5, 10, 30).getDateAndTime());
+    calendar.nextWorkday(date);
+    EXPECT_EQ(date.getDateAndTime(), Date(2024, 7, 8, 10, 30).getDateAndTime());
+    calendar.previousWorkday(date);
+    calendar.previousWorkday(date);
+    EXPECT_EQ(date.getDateAndTime(), Date(2024, 7, 3, 10, 30).getDateAndTime());
+    EXPECT_EQ(calendar.countWorkdays(Date(2024, 7, 1, 0, 0), Date(2024, 7, 8, 0, 0)), 4);
+}
+
+// Compile-time calendar with US style holidays, generated for 2020-2030
+constexpr HolidayRules<3, 2, 1> US_RULES{ WEEKEND_SATURDAY_SUNDAY,
+    {{ { 1, 1, true }, { 7, 4, true }, { 12, 25, true } }},
+    {{ { 11, THURSDAY, 4 }, { 5, MONDAY, LAST_WEEKDAY } }},
+    {{ { 2025, 1, 9 } }} };
+using UsCalendar = StaticCalendar<US_RULES, 2020, 2030>;
+
+// Known deadlines checked while compiling
+static_assert(UsCalendar::isHoliday(TimeUtils::daysFromCivil(2025, 11, 27)), "Thanksgiving 2025");
+static_assert(UsCalendar::isHoliday(TimeUtils::daysFromCivil(2021, 12, 31)), "Jan 1 2022 observed on Friday");
+static_assert(UsCalendar::advanceWorkdays(TimeUtils::daysFromCivil(2025, 12, 23), 2) ==
+    TimeUtils::daysFromCivil(2025, 12, 26), "Two workdays after Dec 23 2025 skip Christmas");
+static_assert(UsCalendar::countWorkdays(TimeUtils::daysFromCivil(2025, 1, 1), TimeUtils::daysFromCivil(2026, 1, 1)) == 255,
+    "Workdays in 2025");
+
+// Test case for a compile-time calendar backing a workday calendar
+TEST(StaticCalendarTest, WorkdayIncrementAndRuleFallback) {
+    BasicWorkdayCalendar<UsCalendar> calendar;
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    EXPECT_EQ(calendar.getWorkdayIncrement(Date(2025, 12, 23, 9, 0), 2.5).getDateAndTime(),
+        Date(2025, 12, 26, 13, 0).getDateAndTime());
+    EXPECT_TRUE(calendar.isHoliday(Date(2025, 5, 26, 0, 0)));
+
+    // Years outside the generated bitmap are answered from the rules
+    int from = TimeUtils::daysFromCivil(2031, 1, 1);
+    int to = TimeUtils::daysFromCivil(2032, 1, 1);
+    int expected = 0;
+    for (int day = from; day < to; ++day) {
+        expected += !UsCalendar::isHolidayByRules(day);
+    }
+    EXPECT_EQ(UsCalendar::countWorkdays(from, to), expected);
+    EXPECT_TRUE(UsCalendar::isHoliday(TimeUtils::daysFromCivil(2031, 11, 27)));
+    EXPECT_EQ(UsCalendar::advanceWorkdays(TimeUtils::daysFromCivil(2030, 12, 30), 3), TimeUtils::daysFromCivil(2031, 1, 3));
+}
+
+// Observed New Year's Eve, which moves into the next year when Dec 31 is a Sunday
+constexpr HolidayRules<1, 0, 0> NEW_YEARS_EVE_RULES{ WEEKEND_SATURDAY_SUNDAY, {{ { 12, 31, true } }}, {}, {} };
+using NewYearsEveCalendar = StaticCalendar<NEW_YEARS_EVE_RULES, 2020, 2030>;
+
+// Test case for an observed holiday shifted forward across the new year
+TEST(StaticCalendarTest, ObservedHolidayIntoNextYear) {
+    // Dec 31 2023 is a Sunday, observed on Monday Jan 1 2024 inside the bitmap
+    EXPECT_TRUE(NewYearsEveCalendar::isHoliday(TimeUtils::daysFromCivil(2024, 1, 1)));
+    EXPECT_FALSE(NewYearsEveCalendar::isHoliday(TimeUtils::daysFromCivil(2024, 1, 2)));
+
+    // Dec 31 2034 is a Sunday, observed on Monday Jan 1 2035 outside the bitmap
+    EXPECT_TRUE(NewYearsEveCalendar::isHolidayByRules(TimeUtils::daysFromCivil(2035, 1, 1)));
+    EXPECT_TRUE(NewYearsEveCalendar::isHoliday(TimeUtils::daysFromCivil(2035, 1, 1)));
+    EXPECT_FALSE(NewYearsEveCalendar::isHoliday(TimeUtils::daysFromCivil(2035, 1, 2)));
+    EXPECT_EQ(NewYearsEveCalendar::countWorkdays(TimeUtils::daysFromCivil(2035, 1, 1), TimeUtils::daysFromCivil(2035, 1, 8)), 4);
+}
+
+// Test case for the checked ValidDate factory and the batch increment
+TEST(ValidDateTest, FactoryAndBatchIncrement) {
+    EXPECT_FALSE(ValidDate::create(Date(2023, 2, 29, 8, 0)).has_value());
+    EXPECT_FALSE(ValidDate::create(Date(2024, 13, 1, 8, 0)).has_value());
+    EXPECT_FALSE(ValidDate::create(Date(2024, 5, 1, 24, 0)).has_value());
+    EXPECT_TRUE(ValidDate::create(Date(2024, 2, 29, 23, 59)).has_value());
+
+    WorkdayCalendar calendar;
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    std::vector<ValidDate> starts;
+    for (int day = 1; day <= 14; ++day) {
+        starts.push_back(*ValidDate::create(Date(2024, 5, day, 10, 30)));
+    }
+    std::vector<Date> results(starts.size());
+    calendar.getWorkdayIncrements(starts, 3.25f, results);
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        EXPECT_EQ(results[i].getDateAndTime(),
+            calendar.getWorkdayIncrement(starts[i].getDate(), 3.25f).getDateAndTime());
+    }
+}
+
+// Test case for exact integer working minute increments
+TEST(WorkingMinutesIncrementTest, ExactMinutes) {
+    WorkdayCalendar calendar;
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    calendar.setRecurringHoliday(Date(2004, 5, 17, 0, 0));
+    const long long workday = 8 * MINUTES_IN_HOUR;
+
+    // Monday 08:00 plus three workdays and 90 minutes, back again
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 8, 0), 3 * workday + 90).getDateAndTime(),
+        Date(2004, 5, 27, 9, 30).getDateAndTime());
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 27, 9, 30), -(3 * workday + 90)).getDateAndTime(),
+        Date(2004, 5, 24, 8, 0).getDateAndTime());
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 8, 0), 0).getDateAndTime(),
+        calendar.getWorkdayIncrement(Date(2004, 5, 24, 8, 0), 0.0f).getDateAndTime());
+
+    // A single minute on top of a long increment is not lost
+    Date whole = calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 8, 0), 20000 * workday);
+    Date plusOne = calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 8, 0), 20000 * workday + 1);
+    EXPECT_EQ(whole.getDate(), plusOne.getDate());
+    EXPECT_EQ(whole.getMinutes() + 1, plusOne.getMinutes());
+
+    // Matches the float API wherever the float is exact
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 12, 0), -10 * workday - 240).getDateAndTime(),
+        calendar.getWorkdayIncrement(Date(2004, 5, 24, 12, 0), -10.5f).getDateAndTime());
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 2, 30, 8, 0), 10).getDateAndTime(),
+        Date(2004, 2, 30, 8, 0).generateInvalidDate().getDateAndTime());
+
+    // More whole workdays than an int holds are rejected, not truncated
+    const long long too_many = workday * (1LL << 32) + workday;
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2024, 5, 6, 10, 0), too_many).getDateAndTime(),
+        Date(2024, 5, 6, 10, 0).generateInvalidDate().getDateAndTime());
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2024, 5, 6, 10, 0), -too_many).getDateAndTime(),
+        Date(2024, 5, 6, 10, 0).generateInvalidDate().getDateAndTime());
+}
+
+// Test case for the epoch minute entry points against the Date ones
+TEST(EpochMinutesTest, MatchesDateIncrement) {
+    WorkdayCalendar calendar;
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    calendar.setHoliday(Date(2004, 5, 27, 0, 0));
+    calendar.setRecurringHoliday(Date(2004, 5, 17, 0, 0));
+
+    EXPECT_EQ(TimeUtils::toEpochMinutes(Date(1970, 1, 2, 1, 5)), MINUTES_IN_DAY + 65);
+    EXPECT_EQ(TimeUtils::fromEpochMinutes(-1).getDateAndTime(), Date(1969, 12, 31, 23, 59).getDateAndTime());
+
+    std::vector<std::int64_t> starts;
+    for (int hour = 0; hour < HOURS_IN_DAY; hour += 5) {
+        for (int day = 10; day <= 31; ++day) {
+            starts.push_back(TimeUtils::toEpochMinutes(Date(2004, 5, day, hour, 17)));
+        }
+    }
+    const long long increments[] = { 0, 1, 479, 480, 5000, -1, -480, -5000, 123456 };
+    std::vector<std::int64_t> results(starts.size());
+    for (long long increment : increments) {
+        calendar.getEpochMinutesIncrements(starts, increment, results);
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            Date expected = calendar.getWorkingMinutesIncrement(TimeUtils::fromEpochMinutes(starts[i]), increment);
+            EXPECT_EQ(TimeUtils::fromEpochMinutes(results[i]).getDateAndTime(), expected.getDateAndTime());
+        }
+    }
+
+    EXPECT_EQ(calendar.getEpochMinutesIncrement(TimeUtils::toEpochMinutes(Date(10000, 1, 1, 0, 0)), 10), INVALID_EPOCH_MINUTES);
+    EXPECT_EQ(calendar.getEpochMinutesIncrement(TimeUtils::toEpochMinutes(Date(2024, 5, 6, 10, 0)), 480LL * (1LL << 32) + 480),
+        INVALID_EPOCH_MINUTES);
+    WorkdayCalendar unset_calendar;
+    EXPECT_EQ(unset_calendar.getEpochMinutesIncrement(0, 10), INVALID_EPOCH_MINUTES);
+}
+
+// Test case for the std::chrono conversions and overloads
+TEST(ChronoTest, ConversionsAndOverloads) {
+    using namespace std::chrono;
+    static_assert(std::is_same_v<SysMinutes::duration, minutes>);
+
+    Date date(2024, 2, 29, 13, 45);
+    EXPECT_EQ(TimeUtils::toSysDays(date), sys_days(2024y / February / 29));
+    EXPECT_EQ(TimeUtils::toYearMonthDay(date), 2024y / February / 29);
+    EXPECT_EQ(TimeUtils::toSysMinutes(date), sys_days(2024y / February / 29) + 13h + 45min);
+    EXPECT_EQ(TimeUtils::fromSysMinutes(TimeUtils::toSysMinutes(date)).getDateAndTime(), date.getDateAndTime());
+    EXPECT_EQ(TimeUtils::fromSysDays(sys_days(1969y / December / 31)).getDateAndTime(), "1969-12-31 00:00");
+    EXPECT_EQ(TimeUtils::fromYearMonthDay(1999y / March / 1, 8, 5).getDateAndTime(), "1999-03-01 08:05");
+
+    WorkdayCalendar calendar;
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    calendar.setRecurringHoliday(Date(2004, 5, 17, 0, 0));
+    EXPECT_TRUE(calendar.isHoliday(sys_days(2024y / May / 17)));
+    EXPECT_FALSE(calendar.isHoliday(sys_days(2024y / May / 16)));
+
+    SysMinutes start = sys_days(2004y / May / 24) + 15h + 7min;
+    EXPECT_EQ(calendar.getWorkdayIncrement(start, -5.5f),
+        TimeUtils::toSysMinutes(calendar.getWorkdayIncrement(TimeUtils::fromSysMinutes(start), -5.5f)));
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(start, 8h + 53min), sys_days(2004y / May / 25) + 16h);
+}
+
+// Test case for work hours passed per query against a calendar configured with the same hours
+TEST(WorkHoursTest, PerQueryHoursShareHolidays) {
+    WorkdayCalendar shared;
+    shared.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    shared.setRecurringHoliday(Date(2004, 5, 17, 0, 0));
+    WorkdayCalendar late_shift;
+    late_shift.setWorkdayStartAndStop(Date(2004, 1, 1, 9, 30), Date(2004, 1, 1, 17, 45));
+    late_shift.setRecurringHoliday(Date(2004, 5, 17, 0, 0));
+    const WorkHours late_hours(9 * MINUTES_IN_HOUR + 30, 17 * MINUTES_IN_HOUR + 45);
+
+    std::vector<std::int64_t> starts;
+    for (int day = 10; day <= 24; ++day) {
+        Date start(2004, 5, day, 7 + day % 12, 3 * day);
+        for (float increment : { 0.5f, 3.25f, -2.75f }) {
+            EXPECT_EQ(shared.getWorkdayIncrement(start, increment, late_hours).getDateAndTime(),
+                late_shift.getWorkdayIncrement(start, increment).getDateAndTime());
+        }
+        starts.push_back(TimeUtils::toEpochMinutes(start));
+    }
+
+    std::vector<std::int64_t> results(starts.size());
+    shared.getEpochMinutesIncrements(starts, 1000, late_hours, results);
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        EXPECT_EQ(results[i], late_shift.getEpochMinutesIncrement(starts[i], 1000));
+    }
+    // The calendar's own hours are untouched
+    EXPECT_EQ(shared.getWorkingMinutesIncrement(Date(2004, 5, 24, 8, 0), 480).getDateAndTime(), "2004-05-25 08:00");
+    EXPECT_EQ(shared.getWorkingMinutesIncrement(Date(2004, 5, 24, 8, 0), 10, WorkHours(600, 600)).getDateAndTime(),
+        Date(2004, 5, 24, 8, 0).generateInvalidDate().getDateAndTime());
+}
+
+// Test case for a weekly schedule with a lunch break and a short Friday
+TEST(WeeklyScheduleTest, ShiftsAndBreaks) {
+    WeeklySchedule schedule;
+    for (int weekday = MONDAY; weekday <= THURSDAY; ++weekday) {
+        schedule.addInterval(weekday, 12 * MINUTES_IN_HOUR + 30, 16 * MINUTES_IN_HOUR);
+        schedule.addInterval(weekday, 8 * MINUTES_IN_HOUR, 12 * MINUTES_IN_HOUR);
+    }
+    schedule.addInterval(FRIDAY, 8 * MINUTES_IN_HOUR, 13 * MINUTES_IN_HOUR);
+    schedule.addInterval(FRIDAY, 12 * MINUTES_IN_HOUR, 14 * MINUTES_IN_HOUR); // overlaps, ignored
+    EXPECT_EQ(schedule.getWorkingMinutes(MONDAY), 450);
+    EXPECT_EQ(schedule.getWorkingMinutes(FRIDAY), 300);
+    EXPECT_EQ(schedule.getWeeklyMinutes(), 4 * 450 + 300);
+    EXPECT_EQ(schedule.workedBefore(MONDAY, 12 * MINUTES_IN_HOUR + 15), 240);
+
+    WorkdayCalendar calendar;
+    // Monday 2004-05-24 to Friday 2004-05-28
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 11, 0), 90, schedule).getDateAndTime(), "2004-05-24 13:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 11, 0), 60, schedule).getDateAndTime(), "2004-05-24 12:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 6, 0), 1, schedule).getDateAndTime(), "2004-05-24 08:01");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 27, 15, 0), 120, schedule).getDateAndTime(), "2004-05-28 09:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 28, 12, 0), 120, schedule).getDateAndTime(), "2004-05-31 09:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 31, 9, 0), -120, schedule).getDateAndTime(), "2004-05-28 12:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 13, 0), -60, schedule).getDateAndTime(), "2004-05-24 11:30");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 13, 0), -30, schedule).getDateAndTime(), "2004-05-24 12:30");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 13, 0), 2 * 450 + 2 * 450 + 300, schedule).getDateAndTime(),
+        "2004-05-31 13:00");
+
+    // Holidays of the shared calendar are skipped
+    calendar.setHoliday(Date(2004, 5, 28, 0, 0));
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 27, 15, 0), 120, schedule).getDateAndTime(), "2004-05-31 09:00");
+
+    // Whole weeks skipped in one go land where steps shorter than a week do
+    calendar.setRecurringHoliday(Date(2004, 12, 27, 0, 0));
+    for (long long direction : { 1LL, -1LL }) {
+        Date stepped(2004, 5, 24, 11, 0);
+        for (int step = 0; step < 100; ++step) {
+            stepped = calendar.getWorkingMinutesIncrement(stepped, direction * 2000, schedule);
+        }
+        EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 11, 0), direction * 200000, schedule).getDateAndTime(),
+            stepped.getDateAndTime());
+    }
+
+    // A single window schedule matches the start/stop calendar away from the window edges
+    WeeklySchedule office;
+    for (int weekday = MONDAY; weekday <= FRIDAY; ++weekday) {
+        office.addInterval(weekday, 8 * MINUTES_IN_HOUR, 16 * MINUTES_IN_HOUR);
+    }
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    std::vector<std::int64_t> starts;
+    for (int day = 17; day <= 31; ++day) {
+        starts.push_back(TimeUtils::toEpochMinutes(Date(2004, 5, day, 10, 17)));
+    }
+    std::vector<std::int64_t> results(starts.size());
+    for (long long increment : { 1000LL, -1000LL, 17LL, -17LL }) {
+        calendar.getEpochMinutesIncrements(starts, increment, office, results);
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            EXPECT_EQ(results[i], calendar.getEpochMinutesIncrement(starts[i], increment));
+        }
+    }
+
+    // Nothing scheduled on the calendar's workdays
+    WeeklySchedule weekend_only;
+    weekend_only.addInterval(SATURDAY, 8 * MINUTES_IN_HOUR, 16 * MINUTES_IN_HOUR);
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 8, 0), 10, weekend_only).getDateAndTime(),
+        Date(2004, 5, 24, 8, 0).generateInvalidDate().getDateAndTime());
+}
+
+// Test case for per-date working windows: an early close and a working Saturday
+TEST(WorkingWindowTest, EarlyCloseAndWorkingSaturday) {
+    WorkdayCalendar calendar;
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    calendar.setWorkingWindow(Date(2004, 12, 24, 0, 0), Date(2004, 1, 1, 8, 0), Date(2004, 1, 1, 12, 0));
+    calendar.setWorkingWindow(Date(2004, 12, 18, 0, 0), Date(2004, 1, 1, 9, 0), Date(2004, 1, 1, 13, 0));
+    calendar.setHoliday(Date(2004, 12, 24, 0, 0)); // the own window wins
+    EXPECT_FALSE(calendar.isHoliday(Date(2004, 12, 18, 0, 0)));
+
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 12, 23, 15, 0), 120).getDateAndTime(), "2004-12-24 09:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 12, 24, 10, 0), 300).getDateAndTime(), "2004-12-27 11:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 12, 24, 14, 0), 60).getDateAndTime(), "2004-12-27 09:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 12, 17, 15, 0), 120).getDateAndTime(), "2004-12-18 10:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 12, 20, 9, 0), -120).getDateAndTime(), "2004-12-18 12:00");
+    EXPECT_EQ(calendar.getWorkdayIncrement(Date(2004, 12, 19, 10, 0), 0.0f).getDateAndTime(), "2004-12-20 08:00");
+
+    // Whole workdays are jumped over between the windows, in both directions
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 12, 1, 10, 0), 22 * 480LL + 240 + 240).getDateAndTime(),
+        "2005-01-03 10:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2005, 1, 3, 10, 0), -(22 * 480LL + 240 + 240)).getDateAndTime(),
+        "2004-12-01 10:00");
+
+    // December 2004: 22 ordinary workdays, a 4 hour Christmas Eve and a 4 hour Saturday
+    GregorianCalendar gregorian;
+    gregorian.setWorkingWindow(Date(2004, 12, 24, 0, 0), 8 * MINUTES_IN_HOUR, 12 * MINUTES_IN_HOUR);
+    gregorian.setWorkingWindow(Date(2004, 12, 18, 0, 0), 9 * MINUTES_IN_HOUR, 13 * MINUTES_IN_HOUR);
+    gregorian.setWorkingWindow(Date(2150, 12, 19, 0, 0), 9 * MINUTES_IN_HOUR, 10 * MINUTES_IN_HOUR);
+    EXPECT_EQ(gregorian.countWorkingMinutes(TimeUtils::daysFromCivil(2004, 12, 1), TimeUtils::daysFromCivil(2005, 1, 1), 480),
+        22 * 480 + 240 + 240);
+    EXPECT_EQ(gregorian.countWorkingMinutes(TimeUtils::daysFromCivil(2150, 12, 19), TimeUtils::daysFromCivil(2150, 12, 22), 480),
+        60 + 480);
+
+    // Same answers with the calendar bound statically
+    GregorianWorkdayCalendar static_calendar;
+    static_calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    static_calendar.setWorkingWindow(Date(2004, 12, 24, 0, 0), Date(2004, 1, 1, 8, 0), Date(2004, 1, 1, 12, 0));
+    EXPECT_EQ(static_calendar.getWorkingMinutesIncrement(Date(2004, 12, 24, 10, 0), 300).getDateAndTime(), "2004-12-27 11:00");
+}
+
+// Test case for a working window far from the queried dates: the results match a calendar without it
+TEST(WorkingWindowTest, OverrideOutsideSpanChangesNothing) {
+    WorkdayCalendar plain;
+    WorkdayCalendar with_window;
+    for (WorkdayCalendar* calendar : { &plain, &with_window }) {
+        calendar->setWorkdayStartAndStop(startWorkday, stopWorkday);
+    }
+    with_window.setWorkingWindow(Date(2030, 12, 24, 0, 0), Date(2004, 1, 1, 8, 0), Date(2004, 1, 1, 12, 0));
+
+    EXPECT_EQ(with_window.getWorkdayIncrement(Date(2004, 5, 24, 16, 0), 1.0f).getDateAndTime(), "2004-05-26 08:00");
+    EXPECT_EQ(with_window.getWorkdayIncrement(Date(2004, 5, 24, 16, 0), 0.0f).getDateAndTime(), "2004-05-25 08:00");
+    EXPECT_EQ(with_window.getWorkdayIncrement(Date(2004, 5, 24, 16, 0), -1.0f).getDateAndTime(), "2004-05-21 16:00");
+    EXPECT_EQ(with_window.getWorkdayIncrement(Date(2004, 5, 24, 7, 0), -1.0f).getDateAndTime(), "2004-05-20 16:00");
+    EXPECT_EQ(with_window.getWorkdayIncrement(Date(2004, 5, 22, 10, 0), 1.0f).getDateAndTime(), "2004-05-25 08:00");
+
+    for (int hour = 0; hour < HOURS_IN_DAY; hour += 2) {
+        for (int day = 20; day <= 27; ++day) {
+            for (long long increment : { 0LL, 1LL, 240LL, 480LL, 481LL, 5000LL, -1LL, -480LL, -481LL, -5000LL }) {
+                Date start(2004, 5, day, hour, 0);
+                EXPECT_EQ(with_window.getWorkingMinutesIncrement(start, increment).getDateAndTime(),
+                    plain.getWorkingMinutesIncrement(start, increment).getDateAndTime())
+                    << start.getDateAndTime() << " + " << increment;
+            }
+        }
+    }
+}
+
+// Test case for increments ending exactly on a window edge next to a day with its own window
+TEST(WorkingWindowTest, ExactDayBoundaryAcrossOverride) {
+    WorkdayCalendar plain;
+    WorkdayCalendar with_window;
+    for (WorkdayCalendar* calendar : { &plain, &with_window }) {
+        calendar->setWorkdayStartAndStop(startWorkday, stopWorkday);
+    }
+    with_window.setWorkingWindow(Date(2004, 12, 24, 0, 0), Date(2004, 1, 1, 8, 0), Date(2004, 1, 1, 12, 0));
+
+    // Whole days from a window start roll over to the next start, as without the window
+    for (WorkdayCalendar* calendar : { &plain, &with_window }) {
+        EXPECT_EQ(calendar->getWorkdayIncrement(Date(2004, 12, 23, 8, 0), 1.0f).getDateAndTime(), "2004-12-24 08:00");
+        EXPECT_EQ(calendar->getWorkdayIncrement(Date(2004, 12, 22, 8, 0), 2.0f).getDateAndTime(), "2004-12-24 08:00");
+    }
+    EXPECT_EQ(with_window.getWorkingMinutesIncrement(Date(2004, 12, 23, 8, 0), 480 + 240).getDateAndTime(), "2004-12-27 08:00");
+    EXPECT_EQ(with_window.getWorkingMinutesIncrement(Date(2004, 12, 23, 9, 0), 420 + 240).getDateAndTime(), "2004-12-24 12:00");
+
+    // Backward from a window stop ends on the previous stop, from inside a window on the start
+    EXPECT_EQ(with_window.getWorkingMinutesIncrement(Date(2004, 12, 27, 16, 0), -(480 + 240)).getDateAndTime(), "2004-12-23 16:00");
+    EXPECT_EQ(with_window.getWorkingMinutesIncrement(Date(2004, 12, 27, 8, 0), -240).getDateAndTime(), "2004-12-24 08:00");
+    EXPECT_EQ(with_window.getWorkingMinutesIncrement(Date(2004, 12, 24, 12, 0), -(240 + 480)).getDateAndTime(), "2004-12-22 16:00");
+}
+
+// Test case for the minute mask calendar against the same working time given as a weekly schedule
+TEST(MinuteMaskCalendarTest, MatchesWeeklySchedule) {
+    auto masks = std::make_unique<MinuteMaskCalendar>();
+    WeeklySchedule schedule;
+    for (int weekday = MONDAY; weekday <= FRIDAY; ++weekday) {
+        masks->setWeekdayMinutes(weekday, 9 * MINUTES_IN_HOUR, 17 * MINUTES_IN_HOUR, true);
+        masks->setWeekdayMinutes(weekday, 12 * MINUTES_IN_HOUR, 13 * MINUTES_IN_HOUR, false);
+        schedule.addInterval(weekday, 9 * MINUTES_IN_HOUR, 12 * MINUTES_IN_HOUR);
+        schedule.addInterval(weekday, 13 * MINUTES_IN_HOUR, 17 * MINUTES_IN_HOUR);
+    }
+    masks->setWeekdayMinutes(WEDNESDAY, 20 * MINUTES_IN_HOUR, 21 * MINUTES_IN_HOUR, true);
+    schedule.addInterval(WEDNESDAY, 20 * MINUTES_IN_HOUR, 21 * MINUTES_IN_HOUR);
+    MinuteMaskCalendar& mask_calendar = *masks;
+
+    WorkdayCalendar by_masks(std::move(masks));
+    WorkdayCalendar by_schedule;
+    for (WorkdayCalendar* calendar : { &by_masks, &by_schedule }) {
+        calendar->setHoliday(Date(2024, 7, 4, 0, 0));
+        calendar->setRecurringHoliday(Date(2024, 12, 25, 0, 0));
+    }
+    EXPECT_EQ(mask_calendar.getWorkingMinutes(TimeUtils::daysFromCivil(2024, 7, 3)), 8 * MINUTES_IN_HOUR);
+    EXPECT_EQ(mask_calendar.getWorkingMinutes(TimeUtils::daysFromCivil(2024, 7, 4)), 0);
+
+    for (int hour = 0; hour < HOURS_IN_DAY; hour += 3) {
+        for (int day = 1; day <= 10; ++day) {
+            for (long long increment : { 1LL, 59LL, 181LL, 420LL, 5000LL, 123457LL, -1LL, -181LL, -5000LL, -123457LL }) {
+                Date start(2024, 7, day, hour, 7 * day);
+                EXPECT_EQ(by_masks.getWorkingMinutesIncrement(start, increment).getDateAndTime(),
+                    by_schedule.getWorkingMinutesIncrement(start, increment, schedule).getDateAndTime())
+                    << start.getDateAndTime() << " + " << increment;
+            }
+        }
+    }
+
+    // A shortened single date
+    mask_calendar.setDateMinutes(Date(2024, 7, 5, 0, 0), 15 * MINUTES_IN_HOUR, 17 * MINUTES_IN_HOUR, false);
+    EXPECT_EQ(by_masks.getWorkingMinutesIncrement(Date(2024, 7, 5, 14, 0), 90).getDateAndTime(), "2024-07-08 09:30");
+    EXPECT_EQ(by_masks.getWorkingMinutesIncrement(Date(2024, 7, 8, 9, 30), -90).getDateAndTime(), "2024-07-05 14:00");
+
+    int from = TimeUtils::daysFromCivil(2024, 1, 1);
+    int to = TimeUtils::daysFromCivil(2026, 1, 1);
+    long long expected = 0;
+    for (int day = from; day < to; ++day) {
+        expected += mask_calendar.getWorkingMinutes(day);
+    }
+    EXPECT_EQ(mask_calendar.countWorkingMinutes(from, to, 0), expected);
+
+    // The masks have no workday length, workday increments are rejected rather than treated as zero
+    const Date invalid_start = Date(2024, 5, 6, 10, 0).generateInvalidDate();
+    EXPECT_EQ(by_masks.getWorkdayIncrement(Date(2024, 5, 6, 10, 0), 2.0f).getDateAndTime(), invalid_start.getDateAndTime());
+    EXPECT_EQ(by_masks.getWorkdayIncrement(Date(2024, 5, 6, 10, 0), 2.0f, WorkHours(8 * MINUTES_IN_HOUR, 16 * MINUTES_IN_HOUR))
+        .getDateAndTime(), invalid_start.getDateAndTime());
+    std::optional<ValidDate> valid_start = ValidDate::create(Date(2024, 5, 6, 10, 0));
+    ASSERT_TRUE(valid_start.has_value());
+    EXPECT_EQ(by_masks.getWorkdayIncrement(*valid_start, 2.0f).getDateAndTime(), invalid_start.getDateAndTime());
+
+    // No working minutes at all
+    WorkdayCalendar empty(std::make_unique<MinuteMaskCalendar>());
+    EXPECT_EQ(empty.getWorkingMinutesIncrement(Date(2024, 7, 5, 14, 0), 10).getDateAndTime(),
+        Date(2024, 7, 5, 14, 0).generateInvalidDate().getDateAndTime());
+}
+
+// Test case for a 22:00-06:00 night shift, anchored to the day it starts on
+TEST(OvernightShiftTest, ShiftsAnchoredToStartDay) {
+    WorkdayCalendar calendar;
+    calendar.setWorkdayStartAndStop(Date(2004, 1, 1, 22, 0), Date(2004, 1, 1, 6, 0));
+    // Friday 2004-05-28 night runs into Saturday, the next shift starts Monday 22:00
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 28, 23, 0), 480).getDateAndTime(), "2004-05-31 23:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 29, 2, 0), 60).getDateAndTime(), "2004-05-29 03:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 29, 5, 30), 60).getDateAndTime(), "2004-05-31 22:30");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 31, 23, 0), -120).getDateAndTime(), "2004-05-29 05:00");
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 25, 12, 0), 30).getDateAndTime(), "2004-05-25 22:30");
+    EXPECT_EQ(calendar.getWorkdayIncrement(Date(2004, 5, 24, 22, 0), 1.5f).getDateAndTime(), "2004-05-26 02:00");
+
+    // No Tuesday night shift on a Tuesday holiday
+    calendar.setHoliday(Date(2004, 5, 25, 0, 0));
+    EXPECT_EQ(calendar.getWorkingMinutesIncrement(Date(2004, 5, 24, 23, 0), 480).getDateAndTime(), "2004-05-26 23:00");
+
+    // Per query hours and compile-time hours agree with the configured ones
+    WorkdayCalendar day_shift;
+    day_shift.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    day_shift.setHoliday(Date(2004, 5, 25, 0, 0));
+    BasicWorkdayCalendar<GregorianCalendar, FixedWorkHours<22 * MINUTES_IN_HOUR, 6 * MINUTES_IN_HOUR>> fixed;
+    fixed.setHoliday(Date(2004, 5, 25, 0, 0));
+    const WorkHours night(22 * MINUTES_IN_HOUR, 6 * MINUTES_IN_HOUR);
+    EXPECT_TRUE(night.isOvernight());
+    EXPECT_EQ(night.getDurationMinutes(), 480);
+    for (int hour = 0; hour < HOURS_IN_DAY; hour += 5) {
+        for (long long minutes : { 1LL, 479LL, 480LL, 3000LL, -1LL, -480LL, -3000LL }) {
+            Date start(2004, 5, 20 + hour % 7, hour, 17);
+            const std::string expected = calendar.getWorkingMinutesIncrement(start, minutes).getDateAndTime();
+            EXPECT_EQ(day_shift.getWorkingMinutesIncrement(start, minutes, night).getDateAndTime(), expected);
+            EXPECT_EQ(fixed.getWorkingMinutesIncrement(start, minutes).getDateAndTime(), expected);
+        }
+    }
+
+    // Per-date windows do not apply to night shifts: their dates work the whole shift, a Saturday included
+    WorkdayCalendar windowed;
+    windowed.setWorkdayStartAndStop(Date(2004, 1, 1, 22, 0), Date(2004, 1, 1, 6, 0));
+    windowed.setWorkingWindow(Date(2004, 5, 26, 0, 0), Date(2004, 1, 1, 10, 0), Date(2004, 1, 1, 14, 0));
+    windowed.setWorkingWindow(Date(2004, 5, 29, 0, 0), Date(2004, 1, 1, 10, 0), Date(2004, 1, 1, 14, 0));
+    EXPECT_EQ(windowed.getWorkingMinutesIncrement(Date(2004, 5, 25, 23, 0), 960).getDateAndTime(), "2004-05-27 23:00");
+    EXPECT_EQ(windowed.getWorkingMinutesIncrement(Date(2004, 5, 28, 23, 0), 480).getDateAndTime(), "2004-05-29 23:00");
+    EXPECT_EQ(windowed.getWorkingMinutesBetween(TimeUtils::toEpochMinutes(Date(2004, 5, 24, 22, 0)),
+        TimeUtils::toEpochMinutes(Date(2004, 5, 28, 6, 0))), 4 * 480);
+    EXPECT_EQ(windowed.getWorkingMinutesBetween(TimeUtils::toEpochMinutes(Date(2004, 5, 25, 23, 0)),
+        TimeUtils::toEpochMinutes(Date(2004, 5, 31, 23, 0))), 5 * 480);
+}
+
+// Test case for 4-on/4-off and 2-2-3 rotations against a day by day walk
+TEST(RotatingCalendarTest, RotationsWithHolidays) {
+    // 4-on/4-off from Monday 2024-07-01: July 1-4, 9-12, 17-20 and 25-28 are worked
+    WorkdayCalendar four_on(std::make_unique<RotatingCalendar>(Date(2024, 7, 1, 0, 0),
+        RotatingCalendar::onOffPattern(4, 4), 8));
+    four_on.setWorkdayStartAndStop(Date(2024, 1, 1, 7, 0), Date(2024, 1, 1, 19, 0));
+    EXPECT_TRUE(four_on.isHoliday(Date(2024, 7, 5, 0, 0)));
+    EXPECT_FALSE(four_on.isHoliday(Date(2024, 7, 20, 0, 0)));
+    EXPECT_EQ(four_on.getWorkdayIncrement(Date(2024, 7, 4, 10, 0), 1.0f).getDateAndTime(), "2024-07-09 10:00");
+    four_on.setHoliday(Date(2024, 7, 10, 0, 0));
+    EXPECT_EQ(four_on.getWorkdayIncrement(Date(2024, 7, 9, 10, 0), 2.5f).getDateAndTime(), "2024-07-12 16:00");
+    EXPECT_EQ(four_on.getWorkdayIncrement(Date(2024, 7, 17, 10, 0), -3.0f).getDateAndTime(), "2024-07-09 10:00");
+
+    // 2-2-3 over 14 days: on on off off on on on off off on on off off off
+    const std::uint64_t two_two_three = 0b00011001110011;
+    RotatingCalendar rotation(Date(2024, 3, 4, 0, 0), two_two_three, 14);
+    EXPECT_EQ(rotation.getWorkdaysPerPeriod(), 7);
+    rotation.setHoliday(Date(2024, 3, 5, 0, 0));
+    rotation.setHoliday(Date(2023, 12, 25, 0, 0));
+    rotation.setRecurringHoliday(Date(2024, 1, 1, 0, 0));
+    rotation.setRecurringHoliday(Date(2024, 7, 4, 0, 0));
+    const int anchor = TimeUtils::daysFromCivil(2024, 3, 4);
+    for (int start = anchor - 400; start < anchor + 400; start += 37) {
+        for (int workdays : { 1, 2, 7, 30, 200, -1, -7, -30, -200 }) {
+            int expected = start;
+            for (int step = 0; step < std::abs(workdays); ++step) {
+                do {
+                    expected += workdays > 0 ? 1 : -1;
+                } while (rotation.isHolidayDay(expected));
+            }
+            EXPECT_EQ(rotation.advanceWorkdaysDay(start, workdays), expected);
+            const int from = std::min(start, expected);
+            const int to = std::max(start, expected);
+            int count = 0;
+            for (int day = from; day < to; ++day) {
+                count += !rotation.isHolidayDay(day);
+            }
+            EXPECT_EQ(rotation.countWorkdaysDay(from, to), count);
+        }
+    }
+}
+
+// Test case for working days in both or either of two calendars
+TEST(CombinedCalendarTest, UnionAndIntersection) {
+    GregorianCalendar germany;
+    germany.setRecurringHoliday(Date(2024, 10, 3, 0, 0));
+    germany.setRecurringHoliday(Date(2024, 12, 26, 0, 0));
+    GregorianCalendar us;
+    us.setRecurringHoliday(Date(2024, 7, 4, 0, 0));
+    us.setHoliday(Date(2024, 11, 28, 0, 0));
+    us.compileIndex(1990, 2060); // not word aligned with the default index
+
+    CombinedCalendar both = CombinedCalendar::intersectionOf({ germany, us });
+    CombinedCalendar either = CombinedCalendar::unionOf({ germany, us });
+    EXPECT_EQ(both.getIndex().getFirstDay(), TimeUtils::daysFromCivil(1990, 1, 1));
+    EXPECT_TRUE(both.isHoliday(Date(2024, 7, 4, 0, 0)));
+    EXPECT_FALSE(either.isHoliday(Date(2024, 7, 4, 0, 0)));
+    EXPECT_TRUE(either.isHoliday(Date(2024, 7, 6, 0, 0)));
+
+    // Inside and outside the combined index
+    for (int year : { 1985, 2024, 2075 }) {
+        const int from = TimeUtils::daysFromCivil(year, 1, 1);
+        for (int day = from; day < from + 366; ++day) {
+            EXPECT_EQ(both.isHolidayDay(day), germany.isHolidayDay(day) || us.isHolidayDay(day));
+            EXPECT_EQ(either.isHolidayDay(day), germany.isHolidayDay(day) && us.isHolidayDay(day));
+        }
+        int expected = from;
+        for (int step = 0; step < 40; ++step) {
+            do {
+                ++expected;
+            } while (both.isHolidayDay(expected));
+        }
+        EXPECT_EQ(both.advanceWorkdaysDay(from, 40), expected);
+        EXPECT_EQ(both.countWorkdays(TimeUtils::fromEpochMinutes(TimeUtils::joinEpochMinutes(from, 0)),
+            TimeUtils::fromEpochMinutes(TimeUtils::joinEpochMinutes(expected, 0))), 39 + !both.isHolidayDay(from));
+    }
+
+    // Own holidays on top of the combination, used through a workday calendar
+    auto combined = std::make_unique<CombinedCalendar>(CombinedCalendar::intersectionOf({ germany, us }));
+    combined->setHoliday(Date(2024, 10, 2, 0, 0));
+    WorkdayCalendar calendar(std::move(combined));
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    EXPECT_EQ(calendar.getWorkdayIncrement(Date(2024, 10, 1, 10, 0), 1.0f).getDateAndTime(), "2024-10-04 10:00");
+    EXPECT_EQ(calendar.getWorkdayIncrement(Date(2024, 7, 3, 10, 0), 1.0f).getDateAndTime(), "2024-07-05 10:00");
+}
+
+// Test case for a ticket handed over between three regional teams
+TEST(FollowTheSunTest, ChainedLegsAndRotation) {
+    WorkdayCalendar europe;
+    europe.setWorkdayStartAndStop(Date(2004, 1, 1, 7, 0), Date(2004, 1, 1, 15, 0));
+    WorkdayCalendar americas;
+    americas.setWorkdayStartAndStop(Date(2004, 1, 1, 15, 0), Date(2004, 1, 1, 23, 0));
+    americas.setHoliday(Date(2004, 5, 31, 0, 0));
+    WorkdayCalendar asia;
+    asia.setWorkdayStartAndStop(Date(2004, 1, 1, 23, 0), Date(2004, 1, 1, 7, 0));
+
+    // Monday 2004-05-24
+    const std::vector<HandoverLeg> legs = { { &europe, 120 }, { &americas, 300 }, { &asia, 240 } };
+    EXPECT_EQ(FollowTheSun::getChainedIncrement(Date(2004, 5, 24, 9, 0), legs).getDateAndTime(), "2004-05-25 03:00");
+    std::int64_t expected = TimeUtils::toEpochMinutes(Date(2004, 5, 28, 14, 0));
+    const std::int64_t start = expected;
+    for (const HandoverLeg& leg : legs) {
+        expected = leg.calendar->getEpochMinutesIncrement(expected, leg.workingMinutes);
+    }
+    EXPECT_EQ(FollowTheSun::getChainedIncrement(start, legs), expected);
+
+    const std::vector<WorkdayCalendar*> teams = { &europe, &americas, &asia };
+    EXPECT_EQ(FollowTheSun::getRotationIncrement(TimeUtils::toEpochMinutes(Date(2004, 5, 24, 7, 0)), teams, 240, 1260),
+        TimeUtils::toEpochMinutes(Date(2004, 5, 26, 0, 0)));
+    EXPECT_EQ(FollowTheSun::getRotationIncrement(start, teams, 0, 1500), INVALID_EPOCH_MINUTES);
+    const std::vector<HandoverLeg> broken = { { &europe, 120 }, { nullptr, 60 } };
+    EXPECT_EQ(FollowTheSun::getChainedIncrement(start, broken), INVALID_EPOCH_MINUTES);
+}
+
+// Test case for working windows in local time of a zone read from tzdata, queried in UTC
+TEST(TimeZoneTest, UtcQueriesAcrossDaylightSavingChanges) {
+    using namespace std::chrono;
+    std::optional<TimeZone> berlin = TimeZone::load("Europe/Berlin");
+    if (!berlin) {
+        GTEST_SKIP() << "tzdata not installed";
+    }
+    EXPECT_FALSE(TimeZone::load("Not/AZone").has_value());
+    auto utc = [](int year, int month, int day, int hour, int minute) {
+        return TimeUtils::toEpochMinutes(Date(year, month, day, hour, minute));
+    };
+    EXPECT_EQ(berlin->getOffsetMinutes(utc(2024, 1, 15, 12, 0)), 60);
+    EXPECT_EQ(berlin->getOffsetMinutes(utc(2024, 3, 31, 0, 59)), 60);
+    EXPECT_EQ(berlin->getOffsetMinutes(utc(2024, 3, 31, 1, 0)), 120);
+    EXPECT_EQ(berlin->getOffsetMinutes(utc(2090, 7, 1, 12, 0)), 120); // from the footer rule
+    EXPECT_EQ(berlin->toUtc(utc(2024, 10, 27, 2, 30)), utc(2024, 10, 27, 0, 30)); // first occurrence
+    EXPECT_EQ(berlin->toUtc(utc(2024, 3, 31, 2, 30)), utc(2024, 3, 31, 1, 30)); // skipped, moved forward
+
+    // 09:00-17:00 local follows the clocks: 16:00 UTC in winter, 15:00 UTC in summer
+    WorkdayCalendar office;
+    office.setWorkdayStartAndStop(Date(2004, 1, 1, 9, 0), Date(2004, 1, 1, 17, 0));
+    EXPECT_EQ(office.getUtcMinutesIncrement(utc(2024, 3, 28, 15, 0), 120, *berlin), utc(2024, 3, 29, 9, 0));
+    EXPECT_EQ(office.getUtcMinutesIncrement(utc(2024, 3, 29, 15, 0), 120, *berlin), utc(2024, 4, 1, 8, 0));
+    EXPECT_EQ(office.getWorkingMinutesIncrement(sys_days(2024y / April / 1) + 8h, -120min, *berlin),
+        sys_days(2024y / March / 29) + 15h);
+
+    // Night shifts every day: the spring shift lasts 7 hours, the autumn shift 9 hours
+    WorkdayCalendar plant(std::make_unique<RotatingCalendar>(Date(2024, 1, 1, 0, 0), RotatingCalendar::onOffPattern(1, 0), 1));
+    plant.setWorkdayStartAndStop(Date(2004, 1, 1, 22, 0), Date(2004, 1, 1, 6, 0));
+    EXPECT_EQ(plant.getUtcMinutesIncrement(utc(2024, 3, 30, 21, 0), 400, *berlin), utc(2024, 3, 31, 3, 40));
+    EXPECT_EQ(plant.getUtcMinutesIncrement(utc(2024, 3, 31, 3, 40), -400, *berlin), utc(2024, 3, 30, 21, 0));
+    EXPECT_EQ(plant.getUtcMinutesIncrement(utc(2024, 10, 26, 20, 0), 530, *berlin), utc(2024, 10, 27, 4, 50));
+    EXPECT_EQ(plant.getUtcMinutesIncrement(utc(2024, 10, 27, 4, 50), -530, *berlin), utc(2024, 10, 26, 20, 0));
+
+    // Without changes in the span the zone only shifts the times
+    std::optional<TimeZone> zero = TimeZone::load("Etc/UTC");
+    ASSERT_TRUE(zero.has_value());
+    std::vector<std::int64_t> starts = { utc(2024, 5, 6, 7, 0), utc(2024, 5, 10, 16, 30), utc(2024, 5, 12, 12, 0) };
+    std::vector<std::int64_t> results(starts.size());
+    office.getUtcMinutesIncrements(starts, 1000, *zero, results);
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        EXPECT_EQ(results[i], office.getEpochMinutesIncrement(starts[i], 1000));
+    }
+}
+
+// Test case for the business-day roll conventions, scalar and batch
+TEST(RollConventionTest, FollowingPrecedingAndModified) {
+    using namespace std::chrono;
+    WorkdayCalendar calendar;
+    calendar.setHoliday(Date(2024, 3, 29, 0, 0));
+    calendar.setRecurringHoliday(Date(2024, 12, 25, 0, 0));
+    calendar.setRecurringHoliday(Date(2024, 12, 26, 0, 0));
+
+    // Saturday 2024-06-29: the next workday is in July
+    const Date end_of_june(2024, 6, 29, 10, 30);
+    EXPECT_EQ(calendar.getRolledDate(end_of_june, RollConvention::Following).getDateAndTime(), Date(2024, 7, 1, 10, 30).getDateAndTime());
+    EXPECT_EQ(calendar.getRolledDate(end_of_june, RollConvention::ModifiedFollowing).getDateAndTime(), Date(2024, 6, 28, 10, 30).getDateAndTime());
+    // Sunday 2024-03-31 after the Friday holiday
+    EXPECT_EQ(calendar.getRolledDate(Date(2024, 3, 31, 0, 0), RollConvention::ModifiedFollowing).getDateAndTime(), Date(2024, 3, 28, 0, 0).getDateAndTime());
+    // Saturday 2024-06-01: the previous workday is in May
+    EXPECT_EQ(calendar.getRolledDate(Date(2024, 6, 1, 0, 0), RollConvention::Preceding).getDateAndTime(), Date(2024, 5, 31, 0, 0).getDateAndTime());
+    EXPECT_EQ(calendar.getRolledDate(Date(2024, 6, 1, 0, 0), RollConvention::ModifiedPreceding).getDateAndTime(), Date(2024, 6, 3, 0, 0).getDateAndTime());
+    // Christmas 2025 falls on Thursday
+    EXPECT_EQ(calendar.getRolledDate(Date(2025, 12, 25, 0, 0), RollConvention::Following).getDateAndTime(), Date(2025, 12, 29, 0, 0).getDateAndTime());
+    EXPECT_EQ(calendar.getRolledDate(Date(2024, 7, 3, 9, 0), RollConvention::Preceding).getDateAndTime(), Date(2024, 7, 3, 9, 0).getDateAndTime());
+    EXPECT_EQ(calendar.getRolledDate(Date(2024, 2, 30, 0, 0), RollConvention::Following).getDateAndTime(),
+        Date(2024, 2, 30, 0, 0).generateInvalidDate().getDateAndTime());
+
+    // The batch agrees with the scalar roll and a day by day walk
+    std::vector<sys_days> days;
+    for (sys_days day = sys_days(2024y / January / 1); day < sys_days(2026y / January / 1); day += std::chrono::days(1)) {
+        days.push_back(day);
+    }
+    std::vector<sys_days> results(days.size());
+    for (RollConvention convention : { RollConvention::Following, RollConvention::ModifiedFollowing,
+        RollConvention::Preceding, RollConvention::ModifiedPreceding }) {
+        ASSERT_TRUE(calendar.getRolledDays(days, convention, results));
+        for (std::size_t i = 0; i < days.size(); ++i) {
+            const bool forward = convention == RollConvention::Following || convention == RollConvention::ModifiedFollowing;
+            const bool modified = convention == RollConvention::ModifiedFollowing || convention == RollConvention::ModifiedPreceding;
+            auto walk = [&calendar](sys_days day, bool next) {
+                while (calendar.isHoliday(day)) {
+                    day += std::chrono::days(next ? 1 : -1);
+                }
+                return day;
+            };
+            sys_days expected = walk(days[i], forward);
+            if (modified && year_month_day(expected).month() != year_month_day(days[i]).month()) {
+                expected = walk(days[i], !forward);
+            }
+            EXPECT_EQ(results[i], expected);
+            int day = static_cast<int>(days[i].time_since_epoch().count());
+            ASSERT_TRUE(calendar.rollDay(day, convention));
+            EXPECT_EQ(day, results[i].time_since_epoch().count());
+        }
+    }
+}
+
+// Test case for the payment schedule grid, its stubs and the roll of its dates
+TEST(PaymentScheduleTest, StubsAndAdjustment) {
+    using namespace std::chrono;
+    // A calendar without days off leaves the grid unadjusted
+    WorkdayCalendar every_day(std::make_unique<RotatingCalendar>(Date(2024, 1, 1, 0, 0), RotatingCalendar::onOffPattern(1, 0), 1));
+    std::vector<sys_days> dates(8);
+    auto schedule = [&](sys_days start, sys_days end, Frequency frequency, StubRule stub) {
+        const std::size_t count = PaymentSchedule::generate(every_day, start, end, frequency, stub, RollConvention::Following, dates);
+        EXPECT_EQ(count, PaymentSchedule::countDates(start, end, frequency, stub));
+        return std::vector<sys_days>(dates.begin(), dates.begin() + count);
+    };
+    const sys_days start = sys_days(2024y / January / 15);
+    const sys_days end = sys_days(2024y / December / 1);
+    EXPECT_EQ(schedule(start, end, Frequency::Quarterly, StubRule::ShortBack), (std::vector<sys_days>{ start,
+        sys_days(2024y / April / 15), sys_days(2024y / July / 15), sys_days(2024y / October / 15), end }));
+    EXPECT_EQ(schedule(start, end, Frequency::Quarterly, StubRule::LongBack), (std::vector<sys_days>{ start,
+        sys_days(2024y / April / 15), sys_days(2024y / July / 15), end }));
+    EXPECT_EQ(schedule(start, end, Frequency::Quarterly, StubRule::ShortFront), (std::vector<sys_days>{ start,
+        sys_days(2024y / March / 1), sys_days(2024y / June / 1), sys_days(2024y / September / 1), end }));
+    EXPECT_EQ(schedule(start, end, Frequency::Quarterly, StubRule::LongFront), (std::vector<sys_days>{ start,
+        sys_days(2024y / June / 1), sys_days(2024y / September / 1), end }));
+    // Month ends stay month ends, without a stub a long rule changes nothing
+    EXPECT_EQ(schedule(sys_days(2024y / March / 31), sys_days(2024y / December / 31), Frequency::Quarterly, StubRule::LongBack),
+        (std::vector<sys_days>{ sys_days(2024y / March / 31), sys_days(2024y / June / 30), sys_days(2024y / September / 30),
+        sys_days(2024y / December / 31) }));
+    EXPECT_EQ(schedule(sys_days(2024y / March / 31), sys_days(2024y / May / 1), Frequency::Annual, StubRule::LongFront),
+        (std::vector<sys_days>{ sys_days(2024y / March / 31), sys_days(2024y / May / 1) }));
+
+    // Rolled on the weekdays: 2024-03-31 and 2024-06-30 are Sundays
+    WorkdayCalendar weekdays;
+    std::vector<sys_days> adjusted(PaymentSchedule::countDates(sys_days(2024y / January / 31), sys_days(2024y / July / 31),
+        Frequency::Monthly, StubRule::ShortBack));
+    ASSERT_EQ(adjusted.size(), 7u);
+    EXPECT_EQ(PaymentSchedule::generate(weekdays, sys_days(2024y / January / 31), sys_days(2024y / July / 31),
+        Frequency::Monthly, StubRule::ShortBack, RollConvention::ModifiedFollowing, adjusted), 7u);
+    EXPECT_EQ(adjusted, (std::vector<sys_days>{ sys_days(2024y / January / 31), sys_days(2024y / February / 29),
+        sys_days(2024y / March / 29), sys_days(2024y / April / 30), sys_days(2024y / May / 31), sys_days(2024y / June / 28),
+        sys_days(2024y / July / 31) }));
+
+    // 30 years monthly, and the rejected calls
+    EXPECT_EQ(PaymentSchedule::countDates(start, sys_days(2054y / January / 15), Frequency::Monthly, StubRule::ShortFront), 361u);
+    EXPECT_EQ(PaymentSchedule::generate(weekdays, start, sys_days(2054y / January / 15), Frequency::Monthly,
+        StubRule::ShortFront, RollConvention::Following, dates), 0u);
+    EXPECT_EQ(PaymentSchedule::countDates(end, start, Frequency::Monthly, StubRule::ShortBack), 0u);
+}
+
+// Test case for the Bus/252 year fractions, scalar and batch
+TEST(YearFractionTest, Business252) {
+    using namespace std::chrono;
+    WorkdayCalendar calendar;
+    calendar.setRecurringHoliday(Date(2024, 1, 1, 0, 0));
+    calendar.setRecurringHoliday(Date(2024, 12, 25, 0, 0));
+    // 262 weekdays in 2024 less the two holidays
+    EXPECT_DOUBLE_EQ(calendar.yearFractionBus252(Date(2024, 1, 1, 0, 0), Date(2025, 1, 1, 0, 0)), 260.0 / 252);
+    EXPECT_DOUBLE_EQ(calendar.yearFractionBus252(sys_days(2025y / January / 1), sys_days(2024y / January / 1)), -260.0 / 252);
+    EXPECT_DOUBLE_EQ(calendar.yearFractionBus252(sys_days(2024y / June / 3), sys_days(2024y / June / 3)), 0.0);
+    EXPECT_TRUE(std::isnan(calendar.yearFractionBus252(Date(2024, 2, 30, 0, 0), Date(2025, 1, 1, 0, 0))));
+
+    // The batch agrees with a day by day count, inside and outside the indexed years
+    std::vector<sys_days> from;
+    std::vector<sys_days> to;
+    for (int i = 0; i < 200; ++i) {
+        from.push_back(sys_days(1995y / March / 7) + std::chrono::days(i * 97));
+        to.push_back(from.back() + std::chrono::days((i * 389) % 1500));
+    }
+    std::vector<double> results(from.size());
+    ASSERT_TRUE(calendar.yearFractionsBus252(from, to, results));
+    for (std::size_t i = 0; i < from.size(); ++i) {
+        int count = 0;
+        for (sys_days day = from[i]; day < to[i]; day += std::chrono::days(1)) {
+            count += !calendar.isHoliday(day);
+        }
+        EXPECT_DOUBLE_EQ(results[i], static_cast<double>(count) / 252) << i;
+    }
+}
+
+// Test case for the nth and last workday of months, quarters and years
+TEST(PeriodQueryTest, NthAndLastWorkdays) {
+    using namespace std::chrono;
+    WorkdayCalendar calendar;
+    calendar.setHoliday(Date(2024, 3, 29, 0, 0));
+    calendar.setRecurringHoliday(Date(2024, 1, 1, 0, 0));
+    calendar.setRecurringHoliday(Date(2024, 12, 31, 0, 0));
+
+    EXPECT_EQ(calendar.getNthWorkdayOfPeriod(Date(2024, 1, 20, 9, 0), CalendarPeriod::Month, 3).getDateAndTime(),
+        Date(2024, 1, 4, 9, 0).getDateAndTime());
+    EXPECT_EQ(calendar.getLastWorkdayOfPeriod(Date(2024, 2, 10, 0, 0), CalendarPeriod::Quarter).getDateAndTime(),
+        Date(2024, 3, 28, 0, 0).getDateAndTime());
+    EXPECT_EQ(calendar.getLastWorkdayOfPeriod(Date(2024, 6, 1, 0, 0), CalendarPeriod::Year).getDateAndTime(),
+        Date(2024, 12, 30, 0, 0).getDateAndTime());
+    EXPECT_EQ(calendar.getNthWorkdayOfPeriod(Date(2024, 12, 1, 0, 0), CalendarPeriod::Quarter, -2).getDateAndTime(),
+        Date(2024, 12, 27, 0, 0).getDateAndTime());
+    EXPECT_EQ(calendar.getNthWorkdayOfPeriod(Date(2024, 2, 1, 0, 0), CalendarPeriod::Month, 22).getDateAndTime(),
+        Date(2024, 2, 1, 0, 0).generateInvalidDate().getDateAndTime());
+    EXPECT_EQ(calendar.getWorkdaysRemaining(Date(2024, 3, 25, 0, 0), CalendarPeriod::Month), 4);
+    EXPECT_EQ(calendar.getWorkdaysRemaining(Date(2024, 1, 1, 0, 0), CalendarPeriod::Year), 259);
+
+    // The batch agrees with walking each month, inside and outside the indexed years
+    std::vector<sys_days> months;
+    for (year_month month = 1998y / January; month <= 2031y / December; month += std::chrono::months(1)) {
+        months.push_back(sys_days(month / 15));
+    }
+    std::vector<sys_days> third(months.size());
+    std::vector<sys_days> last(months.size());
+    ASSERT_TRUE(calendar.getNthWorkdaysOfPeriod(months, CalendarPeriod::Month, 3, third));
+    ASSERT_TRUE(calendar.getNthWorkdaysOfPeriod(months, CalendarPeriod::Month, -1, last));
+    EXPECT_FALSE(calendar.getNthWorkdaysOfPeriod(months, CalendarPeriod::Month, 0, last));
+    for (std::size_t i = 0; i < months.size(); ++i) {
+        const year_month_day ymd(months[i]);
+        std::vector<sys_days> workdays;
+        for (sys_days day = sys_days(ymd.year() / ymd.month() / 1); day <= sys_days(year_month_day_last(ymd.year(), month_day_last(ymd.month())));
+            day += std::chrono::days(1)) {
+            if (!calendar.isHoliday(day)) {
+                workdays.push_back(day);
+            }
+        }
+        EXPECT_EQ(third[i], workdays[2]);
+        EXPECT_EQ(last[i], workdays.back());
+    }
+}
+
+// Test case for 52-53 week fiscal years and their 4-5-4 periods
+TEST(FiscalCalendarTest, PeriodsOfRetailYears) {
+    GregorianCalendar calendar;
+    calendar.setHoliday(Date(2023, 3, 17, 0, 0));
+    // Years ending on the Saturday nearest to January 31; the year ending 2024-02-03 has 53 weeks
+    FiscalCalendar fiscal(calendar, 1, SATURDAY, FiscalYearEnd::NearestWeekday, FiscalPattern::Weeks454, 2010, 2040);
+    EXPECT_TRUE(fiscal.isLongYear(2024));
+    EXPECT_FALSE(fiscal.isLongYear(2023));
+    EXPECT_EQ(FiscalCalendar::yearEndDay(2024, 12, FRIDAY, FiscalYearEnd::LastWeekday), TimeUtils::daysFromCivil(2024, 12, 27));
+
+    std::optional<FiscalPeriod> march = fiscal.getPeriod(Date(2023, 3, 15, 0, 0));
+    ASSERT_TRUE(march.has_value());
+    EXPECT_EQ(march->year, 2024);
+    EXPECT_EQ(march->quarter, 1);
+    EXPECT_EQ(march->period, 2);
+    EXPECT_EQ(march->firstDay, TimeUtils::daysFromCivil(2023, 2, 26));
+    EXPECT_EQ(march->endDay, TimeUtils::daysFromCivil(2023, 4, 2));
+    EXPECT_EQ(march->workdays, 24);
+    EXPECT_EQ(fiscal.getWorkdaysLeftInPeriod(Date(2023, 3, 15, 0, 0)), 12);
+    std::optional<FiscalPeriod> last = fiscal.getPeriod(2024, 12);
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last->firstDay, TimeUtils::daysFromCivil(2023, 12, 31));
+    EXPECT_EQ(last->endDay, TimeUtils::daysFromCivil(2024, 2, 4));
+    EXPECT_FALSE(fiscal.getPeriod(Date(2009, 1, 15, 0, 0)).has_value());
+    EXPECT_EQ(fiscal.getWorkdaysLeftInPeriod(Date(2023, 2, 30, 0, 0)), -1);
+
+    // Every day falls in the period the tables give it, the periods tile the years
+    int previous_end = fiscal.getPeriod(2010, 1)->firstDay;
+    for (int year = 2010; year <= 2040; ++year) {
+        for (int period = 1; period <= FISCAL_PERIODS_IN_YEAR; ++period) {
+            std::optional<FiscalPeriod> expected = fiscal.getPeriod(year, period);
+            ASSERT_TRUE(expected.has_value());
+            EXPECT_EQ(expected->firstDay, previous_end);
+            EXPECT_EQ(expected->workdays, calendar.countWorkdaysDay(expected->firstDay, expected->endDay));
+            for (int day = expected->firstDay; day < expected->endDay; ++day) {
+                std::optional<FiscalPeriod> found = fiscal.getPeriodOfDay(day);
+                ASSERT_TRUE(found.has_value());
+                EXPECT_EQ(found->year, year);
+                EXPECT_EQ(found->period, period);
+            }
+            previous_end = expected->endDay;
+        }
+    }
+}
+
+// Test case for the lazy workday views and their use with std::ranges
+TEST(WorkdayRangeTest, ViewsComposeWithRanges) {
+    using namespace std::chrono;
+    static_assert(std::ranges::bidirectional_range<BasicWorkdayRange<Calendar>>);
+    static_assert(std::ranges::sized_range<BasicWorkdayRange<Calendar>>);
+    static_assert(std::ranges::view<BasicWorkdayRange<GregorianCalendar>>);
+    static_assert(std::ranges::borrowed_range<BasicWorkdayRange<GregorianCalendar>>);
+
+    WorkdayCalendar calendar;
+    GregorianWorkdayCalendar inlined;
+    for (const Date& holiday : { Date(2024, 5, 1, 0, 0), Date(2024, 12, 25, 0, 0), Date(2024, 12, 26, 0, 0) }) {
+        calendar.setHoliday(holiday);
+        inlined.setHoliday(holiday);
+    }
+
+    // Every workday of windows starting and ending on workdays and days off, inside and outside the index
+    const std::vector<std::pair<sys_days, sys_days>> windows = {
+        { sys_days(2024y / April / 27), sys_days(2024y / May / 6) },
+        { sys_days(2024y / December / 20), sys_days(2025y / January / 4) },
+        { sys_days(2099y / December / 25), sys_days(2100y / January / 9) },
+        { sys_days(2024y / May / 4), sys_days(2024y / May / 5) },
+    };
+    for (const auto& [from, to] : windows) {
+        std::vector<sys_days> expected;
+        for (sys_days day = from; day < to; day += std::chrono::days(1)) {
+            if (!calendar.isHoliday(day)) {
+                expected.push_back(day);
+            }
+        }
+        auto view = calendar.workdays(from, to);
+        EXPECT_EQ(std::vector<sys_days>(view.begin(), view.end()), expected);
+        EXPECT_EQ(view.size(), expected.size());
+        auto reversed = view | std::views::reverse;
+        EXPECT_TRUE(std::ranges::equal(reversed, expected | std::views::reverse));
+        EXPECT_TRUE(std::ranges::equal(inlined.workdays(from, to), expected));
+    }
+
+    // Composition: Mondays among the first ten workdays of May 2024
+    auto mondays = calendar.workdays(Date(2024, 5, 1, 0, 0), Date(2024, 6, 1, 0, 0)) | std::views::take(10)
+        | std::views::filter([](sys_days day) { return weekday(day) == Monday; });
+    EXPECT_EQ(std::ranges::distance(mondays), 2);
+    EXPECT_EQ(*std::ranges::begin(mondays), sys_days(2024y / May / 6));
+    EXPECT_TRUE(calendar.workdays(sys_days(2024y / May / 6), sys_days(2024y / May / 6)).empty());
+    EXPECT_TRUE(calendar.workdays(Date(2024, 2, 30, 0, 0), Date(2024, 3, 1, 0, 0)).empty());
+}
+
+// Test case for the coroutine generators of working slots and working intervals
+TEST(GeneratorTest, StreamsSlotsAndIntervals) {
+    static_assert(std::ranges::input_range<Generator<std::int64_t>>);
+    static_assert(std::ranges::view<Generator<WorkingInterval>>);
+    auto at = [](int year, int month, int day, int hour, int minute) {
+        return TimeUtils::toEpochMinutes(Date(year, month, day, hour, minute));
+    };
+
+    WorkdayCalendar calendar;
+    calendar.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    calendar.setHoliday(Date(2024, 5, 9, 0, 0));
+    calendar.setWorkingWindow(Date(2024, 5, 11, 0, 0), Date(2024, 5, 11, 10, 0), Date(2024, 5, 11, 14, 0));
+
+    // Each slot is the previous one incremented, without revalidating
+    std::int64_t expected = at(2024, 5, 6, 9, 30);
+    int slots = 0;
+    for (std::int64_t slot : calendar.generateWorkingSlots(expected, 300) | std::views::take(12)) {
+        expected = calendar.getEpochMinutesIncrement(expected, 300);
+        EXPECT_EQ(slot, expected);
+        ++slots;
+    }
+    EXPECT_EQ(slots, 12);
+    auto backwards = calendar.generateWorkingSlots(at(2024, 5, 13, 9, 0), -120);
+    auto previous = backwards.begin();
+    EXPECT_EQ(*previous, at(2024, 5, 11, 13, 0));
+    ++previous;
+    EXPECT_EQ(*previous, at(2024, 5, 11, 11, 0));
+    auto none = calendar.generateWorkingSlots(at(2024, 5, 6, 8, 0), 0);
+    EXPECT_TRUE(none.begin() == none.end());
+
+    // Intervals: cut at the start, the holiday skipped, the Saturday on its own window
+    std::vector<std::pair<std::int64_t, std::int64_t>> intervals;
+    for (const WorkingInterval& interval : calendar.generateWorkingIntervals(at(2024, 5, 8, 12, 0)) | std::views::take(4)) {
+        intervals.emplace_back(interval.start, interval.stop);
+    }
+    EXPECT_EQ(intervals, (std::vector<std::pair<std::int64_t, std::int64_t>>{
+        { at(2024, 5, 8, 12, 0), at(2024, 5, 8, 16, 0) }, { at(2024, 5, 10, 8, 0), at(2024, 5, 10, 16, 0) },
+        { at(2024, 5, 11, 10, 0), at(2024, 5, 11, 14, 0) }, { at(2024, 5, 13, 8, 0), at(2024, 5, 13, 16, 0) } }));
+
+    // A night shift still running at the start comes first
+    WorkdayCalendar night;
+    night.setWorkdayStartAndStop(Date(2004, 1, 1, 22, 0), Date(2004, 1, 1, 6, 0));
+    auto shifts = night.generateWorkingIntervals(at(2024, 5, 7, 2, 0));
+    auto shift = shifts.begin();
+    EXPECT_EQ((*shift).start, at(2024, 5, 7, 2, 0));
+    EXPECT_EQ((*shift).stop, at(2024, 5, 7, 6, 0));
+    ++shift;
+    EXPECT_EQ((*shift).start, at(2024, 5, 7, 22, 0));
+    EXPECT_EQ((*shift).stop, at(2024, 5, 8, 6, 0));
+}
+
+// Test case for the working minutes between two times and the SLA timer built on them
+TEST(SlaTimerTest, PauseResumeAndSerialization) {
+    auto at = [](int year, int month, int day, int hour, int minute) {
+        return TimeUtils::toEpochMinutes(Date(year, month, day, hour, minute));
+    };
+
+    // Counting the minutes back undoes an increment, whatever the kind of working time
+    WorkdayCalendar office;
+    office.setWorkdayStartAndStop(startWorkday, stopWorkday);
+    office.setHoliday(Date(2024, 5, 9, 0, 0));
+    office.setWorkingWindow(Date(2024, 5, 11, 0, 0), Date(2024, 5, 11, 10, 0), Date(2024, 5, 11, 14, 0));
+    WorkdayCalendar night;
+    night.setWorkdayStartAndStop(Date(2004, 1, 1, 22, 0), Date(2004, 1, 1, 6, 0));
+    auto masks = std::make_unique<MinuteMaskCalendar>();
+    for (int weekday = MONDAY; weekday <= FRIDAY; ++weekday) {
+        masks->setWeekdayMinutes(weekday, 9 * MINUTES_IN_HOUR, 17 * MINUTES_IN_HOUR, true);
+        masks->setWeekdayMinutes(weekday, 12 * MINUTES_IN_HOUR, 13 * MINUTES_IN_HOUR, false);
+    }
+    WorkdayCalendar by_masks(std::move(masks));
+    for (WorkdayCalendar* calendar : { &office, &night, &by_masks }) {
+        for (std::int64_t from : { at(2024, 5, 6, 7, 0), at(2024, 5, 8, 12, 30), at(2024, 5, 10, 23, 0) }) {
+            for (long long minutes : { 1LL, 59LL, 480LL, 1234LL, 10000LL }) {
+                const std::int64_t to = calendar->getEpochMinutesIncrement(from, minutes);
+                EXPECT_EQ(calendar->getWorkingMinutesBetween(from, to), minutes) << from << " + " << minutes;
+            }
+        }
+    }
+    EXPECT_EQ(office.getWorkingMinutesBetween(at(2024, 5, 8, 12, 0), at(2024, 5, 13, 9, 0)), 240 + 480 + 240 + 60);
+    EXPECT_EQ(office.getWorkingMinutesBetween(at(2024, 5, 13, 9, 0), at(2024, 5, 8, 12, 0)), 0);
+
+    // 10 working hours, paused while waiting on the customer
+    SlaTimer timer(&office, 600);
+    EXPECT_FALSE(timer.pause(at(2024, 5, 6, 9, 0)));
+    ASSERT_TRUE(timer.resume(at(2024, 5, 6, 9, 0)));
+    EXPECT_EQ(timer.getBreachTime(), at(2024, 5, 7, 11, 0));
+    ASSERT_TRUE(timer.pause(at(2024, 5, 6, 15, 0)));
+    EXPECT_FALSE(timer.resume(at(2024, 5, 6, 10, 0))); // before the pause, would count 10:00-15:00 twice
+    EXPECT_EQ(timer.getRemainingMinutes(at(2024, 5, 7, 12, 0)), 240);
+    EXPECT_EQ(timer.getBreachTime(), INVALID_EPOCH_MINUTES);
+    ASSERT_TRUE(timer.resume(at(2024, 5, 7, 14, 0)));
+    EXPECT_EQ(timer.getBreachTime(), at(2024, 5, 8, 10, 0));
+    EXPECT_EQ(timer.getRemainingMinutes(at(2024, 5, 8, 9, 0)), 60);
+
+    // The state survives a round trip through its bytes
+    const std::string bytes = timer.serialize();
+    EXPECT_EQ(bytes.size(), SLA_TIMER_SERIALIZED_SIZE);
+    std::optional<SlaTimer> restored = SlaTimer::deserialize(&office, bytes);
+    ASSERT_TRUE(restored.has_value());
+    EXPECT_TRUE(restored->isRunning());
+    EXPECT_EQ(restored->getBreachTime(), timer.getBreachTime());
+    EXPECT_EQ(restored->getElapsedMinutes(at(2024, 5, 8, 9, 0)), 540);
+    EXPECT_FALSE(SlaTimer::deserialize(&office, bytes.substr(1)).has_value());
+
+    // Overrun: the breach time stays once it has passed
+    ASSERT_TRUE(restored->pause(at(2024, 5, 8, 11, 0)));
+    EXPECT_EQ(restored->getRemainingMinutes(at(2024, 5, 8, 11, 0)), -60);
+    EXPECT_EQ(restored->getBreachTime(), at(2024, 5, 8, 10, 0));
+}
+
 // Main function to run tests
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
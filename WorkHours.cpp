@@ -0,0 +1,47 @@
+/**
+ * @file WorkHours.cpp
+ * @brief Implementation file for the RuntimeWorkHours class, holding the run-time configured work hours.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "WorkHours.h"
+
+namespace Workday {
+
+    // **Constructor - work hours unset**
+    RuntimeWorkHours::RuntimeWorkHours()
+        : start_(nullptr), stop_(nullptr), duration_(nullptr),
+        start_minutes_(0), stop_minutes_(0), duration_minutes_(0) {}
+
+    // **Stores start, stop and duration, and their values in minutes**
+    void RuntimeWorkHours::set(const Date& start, const Date& stop) {
+        start_ = std::make_unique<Date>(start.getYear(), start.getMonth(), start.getDay(), start.getHours(),
+            start.getMinutes());  // Creates a unique_ptr to a new Date object with start time
+        stop_ = std::make_unique<Date>(stop.getYear(), stop.getMonth(), stop.getDay(), stop.getHours(),
+            stop.getMinutes());   // Creates a unique_ptr to a new Date object with stop time
+
+        // Calculate the difference between workday stop and start time, wrapping past midnight for a night shift
+        auto [hours, mins] = TimeUtils::subtractTime(stop_->getTime(), start_->getTime());
+        // Create a new Date object to store the workday duration (0 year, month, day)
+        duration_ = std::make_unique<Date>(0, 0, 0, hours, mins);
+
+        start_minutes_ = TimeUtils::convertToMinutes(start_->getTime());
+        stop_minutes_ = TimeUtils::convertToMinutes(stop_->getTime());
+        duration_minutes_ = TimeUtils::convertToMinutes(duration_->getTime());
+    }
+
+    // **Clears start, stop and duration**
+    void RuntimeWorkHours::reset() {
+        start_ = nullptr;
+        stop_ = nullptr;
+        duration_ = nullptr;
+        start_minutes_ = 0;
+        stop_minutes_ = 0;
+        duration_minutes_ = 0;
+    }
+
+} // namespace Workday
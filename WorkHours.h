@@ -0,0 +1,223 @@
+/**
+ * @file WorkHours.h
+ * @brief Header file for the work hour policies used by BasicWorkdayCalendar.
+ *
+ * RuntimeWorkHours holds the workday start and stop set through setWorkdayStartAndStop.
+ * FixedWorkHours bakes start, stop and duration in as compile-time constants, so the
+ * division and modulo by the workday length in the increment path become multiplications.
+ * WorkHours is a plain start/stop value that can be passed to a single query.
+ * A stop before the start is an overnight shift (22:00-06:00): the shift belongs to the day it
+ * starts on and runs past midnight into the next day.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef WORK_HOURS_H
+#define WORK_HOURS_H
+
+#include "Date.h"
+#include "TimeUtils.h"
+#include <memory>
+
+namespace Workday {
+
+    /**
+     * @class RuntimeWorkHours
+     * @brief Workday start and stop configured at run time.
+     */
+    class RuntimeWorkHours {
+    public:
+        /**
+         * @brief Constructor, leaves the work hours unset.
+         */
+        RuntimeWorkHours();
+
+        /**
+         * @brief Sets the start and stop times of the working day.
+         * @param start The start time of the working day.
+         * @param stop The stop time of the working day.
+         */
+        void set(const Date& start, const Date& stop);
+
+        /**
+         * @brief Clears the work hours.
+         */
+        void reset();
+
+        /**
+         * @brief Returns true if start and stop have been set to different times.
+         */
+        bool isSet() const {
+            return start_ && stop_ && duration_ && duration_minutes_ > 0;
+        }
+
+        /**
+         * @brief Returns true if the shift runs past midnight.
+         */
+        bool isOvernight() const {
+            return stop_minutes_ < start_minutes_;
+        }
+
+        /**
+         * @brief Returns the workday start, or nullptr if unset.
+         */
+        Date* getStart() const {
+            return start_.get();
+        }
+
+        /**
+         * @brief Returns the workday stop, or nullptr if unset.
+         */
+        Date* getStop() const {
+            return stop_.get();
+        }
+
+        /**
+         * @brief Returns the workday start in minutes since midnight.
+         */
+        int getStartMinutes() const {
+            return start_minutes_;
+        }
+
+        /**
+         * @brief Returns the workday stop in minutes since midnight.
+         */
+        int getStopMinutes() const {
+            return stop_minutes_;
+        }
+
+        /**
+         * @brief Returns the length of the working day in minutes, across midnight for overnight shifts.
+         */
+        int getDurationMinutes() const {
+            return duration_minutes_;
+        }
+
+    private:
+        //variables holding workday start,stop & duration
+        std::unique_ptr<Date> start_;
+        std::unique_ptr<Date> stop_;
+        std::unique_ptr<Date> duration_;
+        // the same values in minutes, converted once when set
+        int start_minutes_;
+        int stop_minutes_;
+        int duration_minutes_;
+    };
+
+    /**
+     * @class FixedWorkHours
+     * @brief Workday start and stop fixed at compile time.
+     * @tparam StartMinutes Start of the working day in minutes since midnight.
+     * @tparam StopMinutes Stop of the working day in minutes since midnight, before the start for
+     * an overnight shift.
+     */
+    template <int StartMinutes, int StopMinutes>
+    class FixedWorkHours {
+        static_assert(0 <= StartMinutes && StartMinutes < MINUTES_IN_DAY && 0 <= StopMinutes &&
+            StopMinutes <= MINUTES_IN_DAY && StartMinutes != StopMinutes,
+            "FixedWorkHours needs distinct start and stop within one day");
+
+    public:
+        /**
+         * @brief Fixed work hours are always set.
+         */
+        static constexpr bool isSet() {
+            return true;
+        }
+
+        /**
+         * @brief Returns the workday start in minutes since midnight.
+         */
+        static constexpr int getStartMinutes() {
+            return StartMinutes;
+        }
+
+        /**
+         * @brief Returns the workday stop in minutes since midnight.
+         */
+        static constexpr int getStopMinutes() {
+            return StopMinutes;
+        }
+
+        /**
+         * @brief Returns true if the shift runs past midnight.
+         */
+        static constexpr bool isOvernight() {
+            return StopMinutes < StartMinutes;
+        }
+
+        /**
+         * @brief Returns the length of the working day in minutes, across midnight for overnight shifts.
+         */
+        static constexpr int getDurationMinutes() {
+            return isOvernight() ? StopMinutes - StartMinutes + MINUTES_IN_DAY : StopMinutes - StartMinutes;
+        }
+    };
+
+    /**
+     * @class WorkHours
+     * @brief Workday start and stop as a small value, passed per query or per batch.
+     */
+    class WorkHours {
+    public:
+        /**
+         * @brief Constructor.
+         * @param startMinutes Start of the working day in minutes since midnight.
+         * @param stopMinutes Stop of the working day in minutes since midnight, before the start for
+         * an overnight shift.
+         */
+        constexpr WorkHours(int startMinutes, int stopMinutes)
+            : start_minutes_(startMinutes), stop_minutes_(stopMinutes) {}
+
+        /**
+         * @brief Returns true if start and stop differ and both lie within one day.
+         */
+        constexpr bool isSet() const {
+            return 0 <= start_minutes_ && start_minutes_ < MINUTES_IN_DAY && 0 <= stop_minutes_ &&
+                stop_minutes_ <= MINUTES_IN_DAY && start_minutes_ != stop_minutes_;
+        }
+
+        /**
+         * @brief Returns true if the shift runs past midnight.
+         */
+        constexpr bool isOvernight() const {
+            return stop_minutes_ < start_minutes_;
+        }
+
+        /**
+         * @brief Returns the workday start in minutes since midnight.
+         */
+        constexpr int getStartMinutes() const {
+            return start_minutes_;
+        }
+
+        /**
+         * @brief Returns the workday stop in minutes since midnight.
+         */
+        constexpr int getStopMinutes() const {
+            return stop_minutes_;
+        }
+
+        /**
+         * @brief Returns the length of the working day in minutes, across midnight for overnight shifts.
+         */
+        constexpr int getDurationMinutes() const {
+            return isOvernight() ? stop_minutes_ - start_minutes_ + MINUTES_IN_DAY : stop_minutes_ - start_minutes_;
+        }
+
+    private:
+        int start_minutes_; ///< Start in minutes since midnight
+        int stop_minutes_;  ///< Stop in minutes since midnight
+    };
+
+    /**
+     * @brief The common 08:00-16:00 working day.
+     */
+    using StandardWorkHours = FixedWorkHours<8 * MINUTES_IN_HOUR, 16 * MINUTES_IN_HOUR>;
+
+} // namespace Workday
+
+#endif // WORK_HOURS_H
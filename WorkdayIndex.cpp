@@ -0,0 +1,194 @@
+/**
+ * @file WorkdayIndex.cpp
+ * @brief Implementation file for the WorkdayIndex class, a compiled bitmap of workdays over a day range.
+ *
+ * This file contains the implementation of the range queries on the bitmap, answered through rank,
+ * select and bit scans over the 64-bit words.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#include "WorkdayIndex.h"
+#include <algorithm>
+
+namespace Workday {
+
+    // **Default constructor - empty index**
+    WorkdayIndex::WorkdayIndex()
+        : first_day_(0), day_count_(0), words_(), prefix_(1, 0), minute_days_(), day_minutes_(), minutes_prefix_(1, 0) {}
+
+    // **Constructor - covers the given range, all days non-working**
+    WorkdayIndex::WorkdayIndex(int firstDay, int dayCount)
+        : first_day_(firstDay), day_count_(dayCount),
+        words_(BitmapUtils::wordCount(dayCount), 0), prefix_(words_.size() + 1, 0),
+        minute_days_(), day_minutes_(), minutes_prefix_(1, 0) {}
+
+    // **Recomputes the prefix counts from the bitmap and the prefix sums of the day minutes**
+    void WorkdayIndex::updatePrefixCounts() {
+        BitmapUtils::buildPrefixCounts(words_, prefix_);
+        minutes_prefix_.assign(day_minutes_.size() + 1, 0);
+        for (std::size_t i = 0; i < day_minutes_.size(); ++i) {
+            minutes_prefix_[i + 1] = minutes_prefix_[i] + day_minutes_[i];
+        }
+    }
+
+    // **Inserts or replaces the minutes of a day in the sorted sparse table**
+    void WorkdayIndex::setDayMinutes(int day, int minutes) {
+        auto it = std::lower_bound(minute_days_.begin(), minute_days_.end(), day);
+        auto offset = it - minute_days_.begin();
+        if (it != minute_days_.end() && *it == day) {
+            day_minutes_[offset] = minutes;
+            return;
+        }
+        minute_days_.insert(it, day);
+        day_minutes_.insert(day_minutes_.begin() + offset, minutes);
+    }
+
+    // **Bitwise AND with the other index**
+    void WorkdayIndex::intersectWith(const WorkdayIndex& other) {
+        combineWith(other, [](std::uint64_t left, std::uint64_t right) { return left & right; });
+    }
+
+    // **Bitwise OR with the other index**
+    void WorkdayIndex::uniteWith(const WorkdayIndex& other) {
+        combineWith(other, [](std::uint64_t left, std::uint64_t right) { return left | right; });
+    }
+
+    // **Combines aligned words directly, gathers the other's bits one by one when they are shifted**
+    template <typename Op>
+    void WorkdayIndex::combineWith(const WorkdayIndex& other, Op op) {
+        if (empty() || first_day_ < other.first_day_ || getEndDay() > other.getEndDay()) {
+            return;
+        }
+        const int offset = first_day_ - other.first_day_;
+        if (offset % BITS_IN_WORD == 0) {
+            const std::size_t word_offset = offset / BITS_IN_WORD;
+            for (std::size_t i = 0; i < words_.size(); ++i) {
+                words_[i] = op(words_[i], other.words_[i + word_offset]);
+            }
+        }
+        else {
+            for (std::size_t i = 0; i < words_.size(); ++i) {
+                std::uint64_t bits = 0;
+                const int first_bit = static_cast<int>(i) * BITS_IN_WORD;
+                const int last_bit = std::min(first_bit + BITS_IN_WORD, day_count_);
+                for (int bit = first_bit; bit < last_bit; ++bit) {
+                    if (BitmapUtils::testBit(other.words_, bit + offset)) {
+                        bits |= std::uint64_t{ 1 } << (bit - first_bit);
+                    }
+                }
+                words_[i] = op(words_[i], bits);
+            }
+        }
+        // Bits past the last covered day stay clear
+        if (day_count_ % BITS_IN_WORD != 0) {
+            words_.back() &= (std::uint64_t{ 1 } << (day_count_ % BITS_IN_WORD)) - 1;
+        }
+    }
+
+    // **Ordinary workdays times the workday length, plus the own minutes of the stored days**
+    long long WorkdayIndex::countWorkingMinutes(int from, int to, int workdayMinutes) const {
+        from = std::clamp(from, first_day_, first_day_ + day_count_);
+        to = std::clamp(to, first_day_, first_day_ + day_count_);
+        if (to <= from) {
+            return 0;
+        }
+        // Stored days in [from, to), they are workdays in the bitmap
+        const auto first = std::lower_bound(minute_days_.begin(), minute_days_.end(), from) - minute_days_.begin();
+        const auto last = std::lower_bound(minute_days_.begin(), minute_days_.end(), to) - minute_days_.begin();
+        const long long ordinary = countWorkdays(from, to) - (last - first);
+        return ordinary * workdayMinutes + minutes_prefix_[last] - minutes_prefix_[first];
+    }
+
+    // **Masks each word to the range, then counts the bits of every weekday with its own mask**
+    long long WorkdayIndex::countWeekdayMinutes(int from, int to, const std::array<int, DAYS_IN_WEEK>& weekdayMinutes) const {
+        from = std::clamp(from, first_day_, first_day_ + day_count_);
+        to = std::clamp(to, first_day_, first_day_ + day_count_);
+        if (to <= from) {
+            return 0;
+        }
+        // Bits 0, 7, 14, ... 63: the days of a word on the same weekday as its first day
+        const std::uint64_t every_seventh = 0x8102040810204081ULL;
+        const int begin = from - first_day_;
+        const int end = to - first_day_;
+        long long minutes = 0;
+        for (int word = begin / BITS_IN_WORD; word <= (end - 1) / BITS_IN_WORD; ++word) {
+            const int word_start = word * BITS_IN_WORD;
+            std::uint64_t bits = words_[word];
+            if (begin > word_start) {
+                bits &= ~std::uint64_t{ 0 } << (begin - word_start);
+            }
+            if (end < word_start + BITS_IN_WORD) {
+                bits &= (std::uint64_t{ 1 } << (end - word_start)) - 1;
+            }
+            const int first_weekday = TimeUtils::weekdayFromDays(first_day_ + word_start);
+            for (int weekday = 0; weekday < DAYS_IN_WEEK; ++weekday) {
+                if (weekdayMinutes[weekday] != 0) {
+                    const int offset = (weekday - first_weekday + DAYS_IN_WEEK) % DAYS_IN_WEEK;
+                    minutes += static_cast<long long>(weekdayMinutes[weekday]) * std::popcount(bits & (every_seventh << offset));
+                }
+            }
+        }
+        return minutes;
+    }
+
+    // **Counts workdays in [from, to) as the difference of two ranks**
+    int WorkdayIndex::countWorkdays(int from, int to) const {
+        from = std::clamp(from, first_day_, first_day_ + day_count_);
+        to = std::clamp(to, first_day_, first_day_ + day_count_);
+        if (to <= from) {
+            return 0;
+        }
+        return BitmapUtils::rank(words_, prefix_, to - first_day_) -
+            BitmapUtils::rank(words_, prefix_, from - first_day_);
+    }
+
+    // **Scans forward for the next set bit**
+    std::optional<int> WorkdayIndex::nextWorkday(int day) const {
+        if (!contains(day + 1)) {
+            return std::nullopt;
+        }
+        int bit = BitmapUtils::nextSetBit(words_, day + 1 - first_day_);
+        if (bit < 0 || bit >= day_count_) {
+            return std::nullopt;
+        }
+        return first_day_ + bit;
+    }
+
+    // **Scans backward for the previous set bit**
+    std::optional<int> WorkdayIndex::previousWorkday(int day) const {
+        if (!contains(day - 1)) {
+            return std::nullopt;
+        }
+        int bit = BitmapUtils::previousSetBit(words_, day - 1 - first_day_);
+        if (bit < 0) {
+            return std::nullopt;
+        }
+        return first_day_ + bit;
+    }
+
+    // **Selects the workday whose rank is offset by the given count**
+    std::optional<int> WorkdayIndex::advanceWorkdays(int day, int workdays) const {
+        if (!contains(day)) {
+            return std::nullopt;
+        }
+        if (workdays == 0) {
+            return day;
+        }
+        int offset = day - first_day_;
+        // Forward: the n-th workday after day has rank (workdays up to and including day) + n - 1
+        // Backward: the n-th workday before day has rank (workdays before day) - n
+        int target = workdays > 0
+            ? BitmapUtils::rank(words_, prefix_, offset + 1) + workdays - 1
+            : BitmapUtils::rank(words_, prefix_, offset) + workdays;
+        int bit = BitmapUtils::select(words_, prefix_, target);
+        if (bit < 0) {
+            return std::nullopt;
+        }
+        return first_day_ + bit;
+    }
+
+} // namespace Workday
@@ -0,0 +1,207 @@
+/**
+ * @file WorkdayIndex.h
+ * @brief Header file for the Workday::WorkdayIndex class, a compiled bitmap of workdays over a day range.
+ *
+ * The index keeps one bit per calendar day (set for workdays) in 64-bit words, addressed by day
+ * serial (days since 1970-01-01), together with prefix counts of the workdays before each word.
+ * That turns "is this a workday", "how many workdays between", "next workday" and "n-th workday
+ * from here" into bit tests, popcounts and a binary search instead of per-day loops.
+ * Days with their own working window keep their working minutes in a sorted sparse table with
+ * prefix sums, so working minutes over a range stay a few lookups however uneven the days are.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef WORKDAY_INDEX_H
+#define WORKDAY_INDEX_H
+
+#include "BitmapUtils.h"
+#include "TimeUtils.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Workday {
+
+    /**
+     * @class WorkdayIndex
+     * @brief Bitmap of workdays with prefix counts over a contiguous range of day serials.
+     */
+    class WorkdayIndex {
+    public:
+        /**
+         * @brief Default constructor, creates an empty index.
+         */
+        WorkdayIndex();
+
+        /**
+         * @brief Creates an index covering [firstDay, firstDay + dayCount) with no workdays.
+         * @param firstDay The day serial of the first day covered.
+         * @param dayCount The number of days covered.
+         */
+        WorkdayIndex(int firstDay, int dayCount);
+
+        /**
+         * @brief Returns true if the index covers no days.
+         */
+        bool empty() const {
+            return day_count_ == 0;
+        }
+
+        /**
+         * @brief Returns the day serial of the first day covered.
+         */
+        int getFirstDay() const {
+            return first_day_;
+        }
+
+        /**
+         * @brief Returns the day serial one past the last day covered.
+         */
+        int getEndDay() const {
+            return first_day_ + day_count_;
+        }
+
+        /**
+         * @brief Returns true if the day is covered by the index.
+         * @param day The day serial.
+         */
+        bool contains(int day) const {
+            return day >= first_day_ && day < first_day_ + day_count_;
+        }
+
+        /**
+         * @brief Returns true if the covered day is a workday.
+         * @param day The day serial, must be covered by the index.
+         */
+        bool isWorkday(int day) const {
+            return BitmapUtils::testBit(words_, day - first_day_);
+        }
+
+        /**
+         * @brief Marks a covered day as workday or non-workday.
+         * The prefix counts are stale until updatePrefixCounts() is called.
+         * @param day The day serial, must be covered by the index.
+         * @param workday True to mark the day as a workday.
+         */
+        void setWorkday(int day, bool workday) {
+            BitmapUtils::setBit(words_, day - first_day_, workday);
+        }
+
+        /**
+         * @brief Recomputes the prefix counts after the bitmap was modified.
+         */
+        void updatePrefixCounts();
+
+        /**
+         * @brief Counts the workdays in [from, to). Both ends are clamped to the covered range.
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @return The number of workdays, zero if to is not after from.
+         */
+        int countWorkdays(int from, int to) const;
+
+        /**
+         * @brief Finds the first workday strictly after a day.
+         * @param day The day serial.
+         * @return The workday, or nothing if the day after is not covered or no workday follows in the index.
+         */
+        std::optional<int> nextWorkday(int day) const;
+
+        /**
+         * @brief Finds the last workday strictly before a day.
+         * @param day The day serial.
+         * @return The workday, or nothing if the day before is not covered or no workday precedes it in the index.
+         */
+        std::optional<int> previousWorkday(int day) const;
+
+        /**
+         * @brief Moves a covered day by the given number of workdays.
+         * @param day The day serial, must be covered by the index.
+         * @param workdays The number of workdays to move, negative to move backwards.
+         * @return The resulting workday, or nothing if it falls outside the index.
+         */
+        std::optional<int> advanceWorkdays(int day, int workdays) const;
+
+        /**
+         * @brief Keeps only the workdays that are also workdays in another index (bitwise AND). Words are
+         * combined whole when both bitmaps start on the same bit of a word, bit by bit otherwise.
+         * The other index must cover this one; the prefix counts are stale until updatePrefixCounts().
+         * @param other The index to intersect with.
+         */
+        void intersectWith(const WorkdayIndex& other);
+
+        /**
+         * @brief Adds the workdays of another index (bitwise OR), word by word where possible.
+         * The other index must cover this one; the prefix counts are stale until updatePrefixCounts().
+         * @param other The index to unite with.
+         */
+        void uniteWith(const WorkdayIndex& other);
+
+        /**
+         * @brief Stores the working minutes of a covered day with its own working window.
+         * The prefix sums are stale until updatePrefixCounts() is called.
+         * @param day The day serial, must be covered by the index.
+         * @param minutes The working minutes of the day.
+         */
+        void setDayMinutes(int day, int minutes);
+
+        /**
+         * @brief Counts the working minutes in [from, to), clamped to the covered range. Workdays count
+         * workdayMinutes each, except days stored with setDayMinutes, which count their own minutes.
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @param workdayMinutes The working minutes of an ordinary workday.
+         * @return The number of working minutes, zero if to is not after from.
+         */
+        long long countWorkingMinutes(int from, int to, int workdayMinutes) const;
+
+        /**
+         * @brief Counts the working minutes in [from, to), clamped to the covered range, each workday
+         * counting the minutes of its weekday. One masked popcount per weekday and word.
+         * @param from The first day serial.
+         * @param to The day serial one past the last day.
+         * @param weekdayMinutes The working minutes of each weekday, indexed by weekday.
+         * @return The number of working minutes, zero if to is not after from.
+         */
+        long long countWeekdayMinutes(int from, int to, const std::array<int, DAYS_IN_WEEK>& weekdayMinutes) const;
+
+        /**
+         * @brief Returns the bitmap words, bit i standing for day getFirstDay() + i.
+         */
+        const std::vector<std::uint64_t>& getWords() const {
+            return words_;
+        }
+
+        /**
+         * @brief Returns the prefix counts, entry i holding the workdays in words [0, i).
+         */
+        const std::vector<int>& getPrefixCounts() const {
+            return prefix_;
+        }
+
+    private:
+        /**
+         * @brief Combines the words of another index into this one with a bitwise operation.
+         * @param other The index to combine with, covering this one.
+         * @param op The operation applied to each pair of words.
+         */
+        template <typename Op>
+        void combineWith(const WorkdayIndex& other, Op op);
+
+        int first_day_; ///< Day serial of bit 0.
+        int day_count_; ///< Number of days covered.
+        std::vector<std::uint64_t> words_; ///< Workday bitmap.
+        std::vector<int> prefix_; ///< Workdays before each word.
+        std::vector<int> minute_days_; ///< Sorted days with their own working minutes.
+        std::vector<int> day_minutes_; ///< Working minutes of each entry of minute_days_.
+        std::vector<long long> minutes_prefix_; ///< Working minutes of the entries before each entry.
+    };
+
+} // namespace Workday
+
+#endif // WORKDAY_INDEX_H
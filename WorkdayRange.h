@@ -0,0 +1,161 @@
+/**
+ * @file WorkdayRange.h
+ * @brief Header file for the Workday::BasicWorkdayRange view, the workdays of a window as a lazy range.
+ *
+ * The view only keeps the calendar and the first workday at or after each end of the window. Its
+ * bidirectional iterator steps with the calendar's nextWorkdayDay / previousWorkdayDay, which on the
+ * indexed calendars jump to the next set bit of the workday bitmap a word at a time, so walking the
+ * workdays of a window costs one bit scan per workday and no validation or Date conversion. The view
+ * models std::ranges::bidirectional_range and sized_range, the size being one workday count.
+ *
+ * @author Binu Melit Devassy
+ * @date 2024-05-20
+ *
+ * @license MIT License
+ */
+
+#ifndef WORKDAY_RANGE_H
+#define WORKDAY_RANGE_H
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+
+namespace Workday {
+
+    /**
+     * @class BasicWorkdayIterator
+     * @brief Bidirectional iterator over the workdays of a calendar, yielding std::chrono::sys_days.
+     *
+     * @tparam CalendarT The calendar type, providing nextWorkdayDay and previousWorkdayDay.
+     */
+    template <typename CalendarT>
+    class BasicWorkdayIterator {
+    public:
+        using iterator_concept = std::bidirectional_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::chrono::sys_days;
+        using difference_type = std::ptrdiff_t;
+
+        /**
+         * @brief Default constructor, a singular iterator.
+         */
+        BasicWorkdayIterator() = default;
+
+        /**
+         * @brief Constructor.
+         * @param calendar The calendar stepped on, must outlive the iterator.
+         * @param day The day serial of the workday the iterator points at.
+         */
+        BasicWorkdayIterator(const CalendarT* calendar, int day)
+            : calendar_(calendar), day_(day) {
+        }
+
+        /**
+         * @brief Returns the workday.
+         */
+        std::chrono::sys_days operator*() const {
+            return std::chrono::sys_days(std::chrono::days(day_));
+        }
+
+        /**
+         * @brief Returns the day serial of the workday.
+         */
+        int getDaySerial() const {
+            return day_;
+        }
+
+        BasicWorkdayIterator& operator++() {
+            day_ = calendar_->nextWorkdayDay(day_);
+            return *this;
+        }
+
+        BasicWorkdayIterator operator++(int) {
+            BasicWorkdayIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        BasicWorkdayIterator& operator--() {
+            day_ = calendar_->previousWorkdayDay(day_);
+            return *this;
+        }
+
+        BasicWorkdayIterator operator--(int) {
+            BasicWorkdayIterator previous = *this;
+            --*this;
+            return previous;
+        }
+
+        friend bool operator==(const BasicWorkdayIterator& left, const BasicWorkdayIterator& right) {
+            return left.day_ == right.day_;
+        }
+
+    private:
+        const CalendarT* calendar_ = nullptr; ///< Calendar stepped on
+        int day_ = 0; ///< Day serial of the current workday
+    };
+
+    /**
+     * @class BasicWorkdayRange
+     * @brief View of the workdays in the half-open window [from, to) of a calendar.
+     *
+     * @tparam CalendarT The calendar type, providing isHolidayDay, nextWorkdayDay, previousWorkdayDay
+     * and countWorkdaysDay.
+     */
+    template <typename CalendarT>
+    class BasicWorkdayRange : public std::ranges::view_interface<BasicWorkdayRange<CalendarT>> {
+    public:
+        /**
+         * @brief Default constructor, an empty view.
+         */
+        BasicWorkdayRange() = default;
+
+        /**
+         * @brief Constructor.
+         * @param calendar The calendar, must outlive the view and its iterators.
+         * @param from The day serial of the first day of the window.
+         * @param to The day serial one past the last day of the window.
+         */
+        BasicWorkdayRange(const CalendarT* calendar, int from, int to)
+            : calendar_(calendar), first_(0), last_(0) {
+            if (to <= from) {
+                return;
+            }
+            // Both ends sit on workdays so that decrementing the end reaches the last workday of the window
+            first_ = calendar->isHolidayDay(from) ? calendar->nextWorkdayDay(from) : from;
+            last_ = calendar->isHolidayDay(to) ? calendar->nextWorkdayDay(to) : to;
+            if (first_ > last_) {
+                first_ = last_;
+            }
+        }
+
+        BasicWorkdayIterator<CalendarT> begin() const {
+            return BasicWorkdayIterator<CalendarT>(calendar_, first_);
+        }
+
+        BasicWorkdayIterator<CalendarT> end() const {
+            return BasicWorkdayIterator<CalendarT>(calendar_, last_);
+        }
+
+        /**
+         * @brief Returns the number of workdays in the window.
+         */
+        std::size_t size() const {
+            return first_ < last_ ? static_cast<std::size_t>(calendar_->countWorkdaysDay(first_, last_)) : 0;
+        }
+
+    private:
+        const CalendarT* calendar_ = nullptr; ///< Calendar of the workdays
+        int first_ = 0; ///< Day serial of the first workday of the window
+        int last_ = 0; ///< Day serial of the first workday at or after the end of the window
+    };
+
+} // namespace Workday
+
+// The view only refers to the calendar, its iterators stay valid after the view is gone
+template <typename CalendarT>
+inline constexpr bool std::ranges::enable_borrowed_range<Workday::BasicWorkdayRange<CalendarT>> = true;
+
+#endif // WORKDAY_RANGE_H